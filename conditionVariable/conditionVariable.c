@@ -54,7 +54,7 @@ int condVarWait(condVarHandleType *pCondVar, uint32_t waitTicks)
     taskHandleType *currentTask = taskPool.currentTask;
 
 wait:
-    taskQueueAdd(&pCondVar->waitQueue, currentTask);
+    taskQueueAdd(&pCondVar->waitQueue, &currentTask->waitNode);
 
     /* Block current task and give CPU to other tasks while waiting on condition variable*/
     taskBlock(currentTask, WAIT_FOR_COND_VAR, waitTicks);
@@ -66,8 +66,11 @@ wait:
     }
     else if (currentTask->wakeupReason == WAIT_TIMEOUT)
     {
-        /*Wait timed out,remove task from  the waitQueue.*/
-        taskQueueRemove(&pCondVar->waitQueue, currentTask);
+        /*Wait timed out,remove task from  the waitQueue unless it has already been skipped by a signal.*/
+        if (taskQueueNodeLinked(&pCondVar->waitQueue, &currentTask->waitNode))
+        {
+            taskQueueRemove(&pCondVar->waitQueue, &currentTask->waitNode);
+        }
 
         retCode = RET_TIMEOUT;
     }
@@ -75,6 +78,12 @@ wait:
       In this case, retry waiting on condition variable again */
     else
     {
+        /*Task node is still linked in the waitQueue if the task was not picked while it was suspended*/
+        if (taskQueueNodeLinked(&pCondVar->waitQueue, &currentTask->waitNode))
+        {
+            taskQueueRemove(&pCondVar->waitQueue, &currentTask->waitNode);
+        }
+
         goto wait;
     }
 
@@ -103,16 +112,16 @@ getNextSignalTask:
 
     if (nextSignalTask != NULL)
     {
-        /*If task was suspended while waiting on condition varibale, skip the task and get another waiting task from the waitQueue*/
-        if (nextSignalTask->status == TASK_STATUS_SUSPENDED)
+        /*If task was suspended while waiting on condition varibale, or timed out but has not run yet, it is no longer
+          blocked; skip the task and get another waiting task from the waitQueue*/
+        if (nextSignalTask->status != TASK_STATUS_BLOCKED)
         {
             goto getNextSignalTask;
         }
         taskSetReady(nextSignalTask, COND_VAR_SIGNALLED);
 
-        /*Perform context switch if unblocked task has equal or
-         *higher priority[lower priority value] than that of current task */
-        if (nextSignalTask->priority <= taskPool.currentTask->priority)
+        /*Perform context switch if unblocked task should preempt the current task*/
+        if (taskPreemptionRequired(nextSignalTask))
         {
             taskYield();
         }
@@ -137,14 +146,25 @@ int condVarBroadcast(condVarHandleType *pCondVar)
     {
         taskHandleType *pTask = NULL;
 
+        bool contextSwitchRequired = false;
+
         while ((pTask = taskQueueGet(&pCondVar->waitQueue)))
         {
-            if (pTask->status != TASK_STATUS_SUSPENDED)
+            /*Tasks suspended while waiting, or timed out but not run yet, are no longer blocked*/
+            if (pTask->status == TASK_STATUS_BLOCKED)
             {
                 taskSetReady(pTask, COND_VAR_SIGNALLED);
+
+                contextSwitchRequired |= taskPreemptionRequired(pTask);
             }
         }
 
+        /*Perform context switch once if any unblocked task should preempt the current task*/
+        if (contextSwitchRequired)
+        {
+            taskYield();
+        }
+
         return RET_SUCCESS;
     }
     return RET_NOTASK;
@@ -0,0 +1,303 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include "retCodes.h"
+#include "task/task.h"
+#include "scheduler/scheduler.h"
+#include "taskQueue/taskQueue.h"
+#include "eventGroup.h"
+
+/*Wait condition of a task waiting on an event group. It lives on the stack of the waiting task and is
+  referenced by the pWaitData member of its taskHandle struct.*/
+typedef struct
+{
+    uint32_t mask;
+    eventGroupWaitModeType mode;
+    bool clearOnExit;
+    uint32_t flags; // Event flags at the time the wait condition was satisfied
+} eventGroupWaitType;
+
+/**
+ * @brief Check if wait condition is satisfied by the event flags
+ *
+ * @param pWait Pointer to the eventGroupWait struct
+ * @param flags Event flags
+ * @retval true if wait condition is satisfied
+ * @retval false otherwise
+ */
+static inline bool eventGroupWaitSatisfied(eventGroupWaitType *pWait, uint32_t flags)
+{
+    if (pWait->mode == EVENT_GROUP_WAIT_ALL)
+    {
+        return (flags & pWait->mask) == pWait->mask;
+    }
+
+    return (flags & pWait->mask) != 0;
+}
+
+/**
+ * @brief Set event flags and wake up all the waiting tasks whose wait condition is satisfied, in a single pass
+ * over the waitQueue. Flags to be cleared on exit by the woken up tasks are cleared after the pass; hence, every
+ * waiting task sees the same event flags. This function must be called from within a critical section.
+ *
+ * @param pEventGroup Pointer to eventGroupHandle struct
+ * @param flags Event flags to set
+ * @retval true if any woken up task should preempt the current task
+ * @retval false otherwise
+ */
+static bool eventGroupSetUnsafe(eventGroupHandleType *pEventGroup, uint32_t flags)
+{
+    bool contextSwitchRequired = false;
+
+    uint32_t clearFlags = 0;
+
+    taskNodeType *pTaskNode = pEventGroup->waitQueue.head;
+
+    pEventGroup->flags |= flags;
+
+    while (pTaskNode != NULL)
+    {
+        taskNodeType *nextTaskNode = pTaskNode->nextTaskNode;
+
+        taskHandleType *pTask = pTaskNode->pTask;
+
+        eventGroupWaitType *pWait = (eventGroupWaitType *)pTask->pWaitData;
+
+        /*Task suspended while waiting, or timed out but not run yet, is no longer blocked. It stays in the waitQueue
+          and removes itself once it runs.*/
+        if (pTask->status == TASK_STATUS_BLOCKED && eventGroupWaitSatisfied(pWait, pEventGroup->flags))
+        {
+            taskQueueRemove(&pEventGroup->waitQueue, pTaskNode);
+
+            pWait->flags = pEventGroup->flags;
+
+            if (pWait->clearOnExit)
+            {
+                clearFlags |= pWait->mask;
+            }
+
+            taskSetReady(pTask, EVENT_GROUP_FLAGS_SET);
+
+            contextSwitchRequired |= taskPreemptionRequired(pTask);
+        }
+
+        pTaskNode = nextTaskNode;
+    }
+
+    pEventGroup->flags &= ~clearFlags;
+
+    return contextSwitchRequired;
+}
+
+/**
+ * @brief Wait until any or all of the specified event flags are set. This function cannot be called from an ISR.
+ *
+ * @param pEventGroup Pointer to eventGroupHandle struct
+ * @param mask Event flags to wait for
+ * @param mode EVENT_GROUP_WAIT_ANY or EVENT_GROUP_WAIT_ALL
+ * @param clearOnExit If true, flags in mask are cleared once the wait condition is satisfied
+ * @param pFlags Pointer to the variable to be assigned the event flags at the time the wait condition was satisfied or
+ * the wait timed out. Can be NULL.
+ * @param waitTicks Number of ticks to wait if the wait condition is not satisfied
+ * @retval RET_SUCCESS if wait condition is satisfied
+ * @retval RET_BUSY if wait condition is not satisfied
+ * @retval RET_TIMEOUT if timeout occured while waiting for the event flags
+ */
+int eventGroupWait(eventGroupHandleType *pEventGroup, uint32_t mask, eventGroupWaitModeType mode, bool clearOnExit, uint32_t *pFlags, uint32_t waitTicks)
+{
+    assert(pEventGroup != NULL);
+    assert(mask != 0);
+
+    int retCode;
+
+    taskHandleType *currentTask = taskPool.currentTask;
+
+    eventGroupWaitType wait = {.mask = mask, .mode = mode, .clearOnExit = clearOnExit, .flags = 0};
+
+    ENTER_CRITICAL_SECTION();
+
+retry:
+    if (eventGroupWaitSatisfied(&wait, pEventGroup->flags))
+    {
+        wait.flags = pEventGroup->flags;
+
+        if (clearOnExit)
+        {
+            pEventGroup->flags &= ~mask;
+        }
+
+        retCode = RET_SUCCESS;
+    }
+    else if (waitTicks == TASK_NO_WAIT)
+    {
+        wait.flags = pEventGroup->flags;
+
+        retCode = RET_BUSY;
+    }
+    else
+    {
+        currentTask->pWaitData = &wait;
+
+        /*Put current task in event group's wait queue*/
+        taskQueueAdd(&pEventGroup->waitQueue, &currentTask->waitNode);
+
+        /* Block current task and give CPU to other tasks while waiting for event flags*/
+        taskBlock(currentTask, WAIT_FOR_EVENT_GROUP, waitTicks);
+
+        if (currentTask->wakeupReason == EVENT_GROUP_FLAGS_SET)
+        {
+            /*Event flags were recorded and cleared by the task which set them*/
+            retCode = RET_SUCCESS;
+        }
+        else if (currentTask->wakeupReason == WAIT_TIMEOUT)
+        {
+            /*Wait timed out,remove task from  the waitQueue.*/
+            taskQueueRemove(&pEventGroup->waitQueue, &currentTask->waitNode);
+
+            wait.flags = pEventGroup->flags;
+
+            retCode = RET_TIMEOUT;
+        }
+        /*Task might have been suspended while waiting for event flags and later resumed.
+          In this case, check the event flags again */
+        else
+        {
+            if (taskQueueNodeLinked(&pEventGroup->waitQueue, &currentTask->waitNode))
+            {
+                taskQueueRemove(&pEventGroup->waitQueue, &currentTask->waitNode);
+            }
+
+            goto retry;
+        }
+
+        currentTask->pWaitData = NULL;
+    }
+
+    EXIT_CRITICAL_SECTION();
+
+    if (pFlags != NULL)
+    {
+        *pFlags = wait.flags;
+    }
+
+    return retCode;
+}
+
+/**
+ * @brief Set event flags and wake up the waiting tasks whose wait condition is satisfied.
+ *
+ * @param pEventGroup Pointer to eventGroupHandle struct
+ * @param flags Event flags to set
+ * @retval RET_SUCCESS if event flags are set
+ */
+int eventGroupSet(eventGroupHandleType *pEventGroup, uint32_t flags)
+{
+    assert(pEventGroup != NULL);
+
+    bool contextSwitchRequired;
+
+    ENTER_CRITICAL_SECTION();
+
+    contextSwitchRequired = eventGroupSetUnsafe(pEventGroup, flags);
+
+    EXIT_CRITICAL_SECTION();
+
+    if (contextSwitchRequired)
+    {
+        taskYield();
+    }
+
+    return RET_SUCCESS;
+}
+
+/**
+ * @brief Set event flags from an ISR. If a woken up task should preempt the current task, context switch
+ * is performed once all pending ISRs have been serviced.
+ *
+ * @param pEventGroup Pointer to eventGroupHandle struct
+ * @param flags Event flags to set
+ * @retval RET_SUCCESS if event flags are set
+ */
+int eventGroupSetFromISR(eventGroupHandleType *pEventGroup, uint32_t flags)
+{
+    assert(pEventGroup != NULL);
+
+    bool contextSwitchRequired;
+
+    uint32_t savedState = ENTER_CRITICAL_SECTION_FROM_ISR();
+
+    contextSwitchRequired = eventGroupSetUnsafe(pEventGroup, flags);
+
+    EXIT_CRITICAL_SECTION_FROM_ISR(savedState);
+
+    if (contextSwitchRequired)
+    {
+        taskYieldFromISR();
+    }
+
+    return RET_SUCCESS;
+}
+
+/**
+ * @brief Clear event flags
+ *
+ * @param pEventGroup Pointer to eventGroupHandle struct
+ * @param flags Event flags to clear
+ * @retval RET_SUCCESS if event flags are cleared
+ */
+int eventGroupClear(eventGroupHandleType *pEventGroup, uint32_t flags)
+{
+    assert(pEventGroup != NULL);
+
+    ENTER_CRITICAL_SECTION();
+
+    pEventGroup->flags &= ~flags;
+
+    EXIT_CRITICAL_SECTION();
+
+    return RET_SUCCESS;
+}
+
+/**
+ * @brief Clear event flags from an ISR
+ *
+ * @param pEventGroup Pointer to eventGroupHandle struct
+ * @param flags Event flags to clear
+ * @retval RET_SUCCESS if event flags are cleared
+ */
+int eventGroupClearFromISR(eventGroupHandleType *pEventGroup, uint32_t flags)
+{
+    assert(pEventGroup != NULL);
+
+    uint32_t savedState = ENTER_CRITICAL_SECTION_FROM_ISR();
+
+    pEventGroup->flags &= ~flags;
+
+    EXIT_CRITICAL_SECTION_FROM_ISR(savedState);
+
+    return RET_SUCCESS;
+}
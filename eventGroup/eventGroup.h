@@ -0,0 +1,85 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __SANO_RTOS_EVENT_GROUP_H
+#define __SANO_RTOS_EVENT_GROUP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "osConfig.h"
+#include "task/task.h"
+#include "taskQueue/taskQueue.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Statically define and initialize an event group of 32 event flags.
+ * @param name Name of the event group.
+ */
+#define EVENT_GROUP_DEFINE(name)  \
+    eventGroupHandleType name = { \
+        .waitQueue = {0},         \
+        .flags = 0}
+
+    typedef enum
+    {
+        EVENT_GROUP_WAIT_ANY, // Wait until any of the flags is set
+        EVENT_GROUP_WAIT_ALL  // Wait until all of the flags are set
+    } eventGroupWaitModeType;
+
+    typedef struct
+    {
+        taskQueueType waitQueue;
+        uint32_t flags;
+    } eventGroupHandleType;
+
+    /**
+     * @brief Get current event flags of the event group
+     *
+     * @param pEventGroup Pointer to eventGroupHandle struct
+     * @return Event flags
+     */
+    static inline uint32_t eventGroupGet(eventGroupHandleType *pEventGroup)
+    {
+        return pEventGroup->flags;
+    }
+
+    int eventGroupWait(eventGroupHandleType *pEventGroup, uint32_t mask, eventGroupWaitModeType mode, bool clearOnExit, uint32_t *pFlags, uint32_t waitTicks);
+
+    int eventGroupSet(eventGroupHandleType *pEventGroup, uint32_t flags);
+
+    int eventGroupSetFromISR(eventGroupHandleType *pEventGroup, uint32_t flags);
+
+    int eventGroupClear(eventGroupHandleType *pEventGroup, uint32_t flags);
+
+    int eventGroupClearFromISR(eventGroupHandleType *pEventGroup, uint32_t flags);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
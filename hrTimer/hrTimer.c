@@ -0,0 +1,274 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include "retCodes.h"
+#include "osConfig.h"
+#include "scheduler/scheduler.h"
+#include "task/task.h"
+#include "hrTimer.h"
+
+#if OS_HR_TIMER
+
+static hrTimerNodeType *hrTimerList = NULL; // List of running high resolution timers sorted by expiry
+
+/**
+ * @brief Check if counter value a is before counter value b. Counter wraps around; hence, timeouts must be
+ * shorter than half of the counter range.
+ *
+ * @retval true if a is before b
+ * @retval false otherwise
+ */
+static inline bool hrTimerBefore(uint32_t a, uint32_t b)
+{
+    return (int32_t)(a - b) < 0;
+}
+
+/**
+ * @brief Arm the compare channel for the earliest running timer, or disable it if no timer is running.
+ */
+static inline void hrTimerCompareUpdate()
+{
+    if (hrTimerList != NULL)
+    {
+        hrTimerPortCompareSet(hrTimerList->expiryCount);
+    }
+    else
+    {
+        hrTimerPortCompareDisable();
+    }
+}
+
+/**
+ * @brief Insert timer into the list of running timers. Timers with equal expiry are kept in FIFO order.
+ * Must be called from within a critical section.
+ *
+ * @param pHrTimerNode Pointer to hrTimerNode struct
+ * @param timeoutUs Timeout in microseconds
+ */
+static void hrTimerStartUnsafe(hrTimerNodeType *pHrTimerNode, uint32_t timeoutUs)
+{
+    hrTimerNodeType **ppNode = &hrTimerList;
+
+    pHrTimerNode->expiryCount = hrTimerPortCounterGet() + US_TO_HR_TIMER_COUNTS(timeoutUs);
+    pHrTimerNode->isRunning = true;
+
+    while (*ppNode != NULL && !hrTimerBefore(pHrTimerNode->expiryCount, (*ppNode)->expiryCount))
+    {
+        ppNode = &(*ppNode)->nextNode;
+    }
+
+    pHrTimerNode->nextNode = *ppNode;
+    *ppNode = pHrTimerNode;
+
+    /*Re-arm compare channel if the timer became the earliest one*/
+    if (hrTimerList == pHrTimerNode)
+    {
+        hrTimerCompareUpdate();
+    }
+}
+
+/**
+ * @brief Remove timer from the list of running timers. Must be called from within a critical section.
+ *
+ * @param pHrTimerNode Pointer to hrTimerNode struct
+ */
+static void hrTimerStopUnsafe(hrTimerNodeType *pHrTimerNode)
+{
+    hrTimerNodeType **ppNode = &hrTimerList;
+
+    while (*ppNode != NULL && *ppNode != pHrTimerNode)
+    {
+        ppNode = &(*ppNode)->nextNode;
+    }
+
+    if (*ppNode != NULL)
+    {
+        bool wasEarliest = (hrTimerList == pHrTimerNode);
+
+        *ppNode = pHrTimerNode->nextNode;
+
+        if (wasEarliest)
+        {
+            hrTimerCompareUpdate();
+        }
+    }
+
+    pHrTimerNode->nextNode = NULL;
+    pHrTimerNode->isRunning = false;
+}
+
+/**
+ * @brief Initialize the high resolution counter. Called by the scheduler on start.
+ */
+void hrTimerInit()
+{
+    hrTimerPortInit();
+
+    hrTimerPortCompareDisable();
+}
+
+/**
+ * @brief Compare interrupt handler. Must be called from the interrupt handler of the compare channel. Timeout
+ * handlers of all the expired timers are called, and the compare channel is armed for the next timer.
+ */
+void hrTimerCompareHandler()
+{
+    uint32_t savedState = ENTER_CRITICAL_SECTION_FROM_ISR();
+
+    while (hrTimerList != NULL && !hrTimerBefore(hrTimerPortCounterGet(), hrTimerList->expiryCount))
+    {
+        hrTimerNodeType *pHrTimerNode = hrTimerList;
+
+        hrTimerList = pHrTimerNode->nextNode;
+
+        pHrTimerNode->nextNode = NULL;
+        pHrTimerNode->isRunning = false;
+
+        pHrTimerNode->timeoutHandler(pHrTimerNode, pHrTimerNode->arg);
+    }
+
+    hrTimerCompareUpdate();
+
+    EXIT_CRITICAL_SECTION_FROM_ISR(savedState);
+}
+
+/**
+ * @brief Start a single shot high resolution timer. The timeout handler is called from the compare interrupt.
+ *
+ * @param pHrTimerNode Pointer to hrTimerNode struct
+ * @param timeoutUs Timeout in microseconds
+ * @retval RET_SUCCESS if timer started successfully
+ * @retval RET_ALREADYACTIVE if timer is already running
+ */
+int hrTimerStart(hrTimerNodeType *pHrTimerNode, uint32_t timeoutUs)
+{
+    assert(pHrTimerNode != NULL);
+
+    int retCode = RET_ALREADYACTIVE;
+
+    ENTER_CRITICAL_SECTION();
+
+    if (!pHrTimerNode->isRunning)
+    {
+        hrTimerStartUnsafe(pHrTimerNode, timeoutUs);
+
+        retCode = RET_SUCCESS;
+    }
+
+    EXIT_CRITICAL_SECTION();
+
+    return retCode;
+}
+
+/**
+ * @brief Stop a running high resolution timer.
+ *
+ * @param pHrTimerNode Pointer to hrTimerNode struct
+ * @retval RET_SUCCESS if timer stopped successfully
+ * @retval RET_NOTACTIVE if timer is not running
+ */
+int hrTimerStop(hrTimerNodeType *pHrTimerNode)
+{
+    assert(pHrTimerNode != NULL);
+
+    int retCode = RET_NOTACTIVE;
+
+    ENTER_CRITICAL_SECTION();
+
+    if (pHrTimerNode->isRunning)
+    {
+        hrTimerStopUnsafe(pHrTimerNode);
+
+        retCode = RET_SUCCESS;
+    }
+
+    EXIT_CRITICAL_SECTION();
+
+    return retCode;
+}
+
+/**
+ * @brief Timeout handler of high resolution sleeps. Wake up the sleeping task.
+ *
+ * @param pHrTimerNode Pointer to hrTimerNode struct
+ * @param arg Pointer to taskHandle struct of the sleeping task
+ */
+static void hrTimerSleepTimeout(hrTimerNodeType *pHrTimerNode, void *arg)
+{
+    (void)pHrTimerNode;
+
+    taskHandleType *pTask = (taskHandleType *)arg;
+
+    if (pTask->status == TASK_STATUS_BLOCKED)
+    {
+        taskSetReady(pTask, SLEEP_TIME_TIMEOUT);
+
+        if (taskPreemptionRequired(pTask))
+        {
+            taskYieldFromISR();
+        }
+    }
+}
+
+/**
+ * @brief Block task for specified number of microseconds using the high resolution counter instead of the OS tick.
+ *
+ * @param sleepTimeUS Sleep time in microseconds
+ */
+void hrTimerSleepUS(uint32_t sleepTimeUS)
+{
+    taskHandleType *currentTask = taskPool.currentTask;
+
+    /*Timer node lives on the stack of the sleeping task*/
+    hrTimerNodeType sleepTimer = {
+        .timeoutHandler = hrTimerSleepTimeout,
+        .arg = currentTask,
+        .expiryCount = 0,
+        .nextNode = NULL,
+        .isRunning = false};
+
+    if (US_TO_HR_TIMER_COUNTS(sleepTimeUS) == 0)
+    {
+        return;
+    }
+
+    ENTER_CRITICAL_SECTION();
+
+    hrTimerStartUnsafe(&sleepTimer, sleepTimeUS);
+
+    taskBlock(currentTask, SLEEP, TASK_MAX_WAIT);
+
+    /*Task might have been suspended and resumed before the timeout; timer node must not be left in the list*/
+    if (sleepTimer.isRunning)
+    {
+        hrTimerStopUnsafe(&sleepTimer);
+    }
+
+    EXIT_CRITICAL_SECTION();
+}
+
+#endif
@@ -0,0 +1,110 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __SANO_RTOS_HR_TIMER_H
+#define __SANO_RTOS_HR_TIMER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "osConfig.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /*
+     * High resolution timeouts for waits shorter than an OS tick. A free running hardware counter with a compare channel
+     * is armed for the earliest timeout; coarse timeouts keep using the OS tick. The counter is accessed through the port
+     * functions below, which must be provided for the target along with an interrupt handler calling hrTimerCompareHandler().
+     * Priority of the compare interrupt must not be above KERNEL_MAX_SYSCALL_PRIORITY. Defining OS_HR_TIMER_SIM selects a
+     * simulated port which lets high resolution timeouts run on a host.
+     */
+
+/*Convert microseconds to counts of the high resolution counter*/
+#define US_TO_HR_TIMER_COUNTS(us) ((uint32_t)((uint64_t)(us) * OS_HR_TIMER_FREQUENCY_HZ / 1000000))
+
+/**
+ * @brief Statically define and initialize a high resolution timer.
+ * @param name Name of the timer.
+ * @param timeout_handler Function to be called from the compare interrupt when the timer expires.
+ * @param timer_arg Argument passed to the timeout handler.
+ */
+#define HR_TIMER_DEFINE(name, timeout_handler, timer_arg)           \
+    void timeout_handler(hrTimerNodeType *pHrTimerNode, void *arg); \
+    hrTimerNodeType name = {                                        \
+        .timeoutHandler = timeout_handler,                          \
+        .arg = timer_arg,                                           \
+        .expiryCount = 0,                                           \
+        .nextNode = NULL,                                           \
+        .isRunning = false}
+
+    typedef struct hrTimerNode hrTimerNodeType;
+
+    /*High resolution timeout handlers are called from the compare interrupt; hence, they may only call the FromISR APIs.*/
+    typedef void (*hrTimeoutHandlerType)(hrTimerNodeType *pHrTimerNode, void *arg);
+
+    struct hrTimerNode
+    {
+        hrTimeoutHandlerType timeoutHandler;
+        void *arg;
+        uint32_t expiryCount;        // Counter value at which the timer expires
+        struct hrTimerNode *nextNode; // Links the timer into the list of running timers sorted by expiry
+        bool isRunning;
+    };
+
+    /*Port functions*/
+
+    void hrTimerPortInit();
+
+    uint32_t hrTimerPortCounterGet();
+
+    /*Arm the compare channel. If the counter has already reached compareValue, the compare interrupt must be raised immediately.*/
+    void hrTimerPortCompareSet(uint32_t compareValue);
+
+    void hrTimerPortCompareDisable();
+
+    /*Kernel functions*/
+
+    void hrTimerInit();
+
+    void hrTimerCompareHandler();
+
+    int hrTimerStart(hrTimerNodeType *pHrTimerNode, uint32_t timeoutUs);
+
+    int hrTimerStop(hrTimerNodeType *pHrTimerNode);
+
+    void hrTimerSleepUS(uint32_t sleepTimeUS);
+
+#if OS_HR_TIMER_SIM
+
+    void hrTimerSimAdvance(uint32_t counts);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
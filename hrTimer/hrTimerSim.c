@@ -0,0 +1,106 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "osConfig.h"
+#include "hrTimer.h"
+
+#if (OS_HR_TIMER) && (OS_HR_TIMER_SIM)
+
+static uint32_t simCounter; // Current value of the simulated counter
+
+static uint32_t simCompareValue; // Value of the simulated compare register
+
+static bool simCompareEnabled;
+
+/**
+ * @brief Initialize the simulated counter.
+ */
+void hrTimerPortInit()
+{
+    simCounter = 0;
+    simCompareEnabled = false;
+}
+
+/**
+ * @brief Get current value of the simulated counter.
+ *
+ * @return Counter value
+ */
+uint32_t hrTimerPortCounterGet()
+{
+    return simCounter;
+}
+
+/**
+ * @brief Arm the simulated compare channel. A compare value in the past raises the interrupt on the next call to hrTimerSimAdvance.
+ *
+ * @param compareValue Counter value at which the compare interrupt is raised
+ */
+void hrTimerPortCompareSet(uint32_t compareValue)
+{
+    simCompareValue = compareValue;
+    simCompareEnabled = true;
+}
+
+/**
+ * @brief Disable the simulated compare channel.
+ */
+void hrTimerPortCompareDisable()
+{
+    simCompareEnabled = false;
+}
+
+/**
+ * @brief Advance the simulated counter. The compare interrupt handler is called when the counter reaches the compare value,
+ * which also covers a compare value set in the past. Passing 0 only raises the interrupt of a compare value in the past.
+ *
+ * @param counts Number of counts to advance the counter by
+ */
+void hrTimerSimAdvance(uint32_t counts)
+{
+    do
+    {
+        uint32_t step = counts;
+
+        /*Stop at the compare value to call the handler at the exact counter value*/
+        if (simCompareEnabled && (int32_t)(simCompareValue - simCounter) > 0 && simCompareValue - simCounter < step)
+        {
+            step = simCompareValue - simCounter;
+        }
+
+        simCounter += step;
+        counts -= step;
+
+        if (simCompareEnabled && (int32_t)(simCounter - simCompareValue) >= 0)
+        {
+            simCompareEnabled = false;
+
+            hrTimerCompareHandler();
+        }
+    } while (counts != 0);
+}
+
+#endif
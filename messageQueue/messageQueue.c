@@ -31,102 +31,437 @@
 #include "scheduler/scheduler.h"
 #include "taskQueue/taskQueue.h"
 
+/*Returned by msgQueueWaitForData if the item has been copied directly to the destination of the waiting task*/
+#define MSG_QUEUE_RECEIVED_DIRECTLY 1
+
+/*Wait condition of a consumer task blocked on the queue. It lives on the stack of the waiting task and is referenced
+  by the pWaitData field of its taskHandle struct.*/
+typedef struct
+{
+    void *pItem;       // Destination a producer task may copy the item to directly. NULL if items are consumed from the queue buffer
+    uint32_t minCount; // Minimum number of items the task waits for
+} msgQueueReceiveWaitType;
+
 /**
- * @brief Insert an item to the queue buffer
+ * @brief Advance ring buffer slot index by one. No division is performed; the index is masked for queues
+ * with power of two length and wrapped around by comparison otherwise.
  *
  * @param pQueueHandle
- * @param pItem
+ * @param index Slot index
+ * @return Index of the next slot
  */
-static void msgQueueBufferWrite(msgQueueHandleType *pQueueHandle, void *pItem)
+static inline uint32_t msgQueueIndexNext(msgQueueHandleType *pQueueHandle, uint32_t index)
 {
+    if (pQueueHandle->indexMask != 0)
+    {
+        return (index + 1) & pQueueHandle->indexMask;
+    }
 
-    bool contextSwitchRequired = false;
+    return (index + 1 == pQueueHandle->queueLength) ? 0 : index + 1;
+}
 
-    taskHandleType *consumer = NULL;
+/**
+ * @brief Get address of a ring buffer slot
+ *
+ * @param pQueueHandle
+ * @param index Slot index
+ * @return Pointer to the slot
+ */
+static inline uint8_t *msgQueueSlot(msgQueueHandleType *pQueueHandle, uint32_t index)
+{
+    return &pQueueHandle->buffer[index * pQueueHandle->itemSize];
+}
 
-    ENTER_CRITICAL_SECTION();
+/**
+ * @brief Copy an item. Common item sizes are copied with fixed size copies, which the compiler turns into
+ * load/store instructions instead of a call to the generic memcpy.
+ *
+ * @param pDst Destination
+ * @param pSrc Source
+ * @param itemSize Size of the item in bytes
+ */
+static inline void msgQueueItemCopy(void *pDst, const void *pSrc, uint32_t itemSize)
+{
+    switch (itemSize)
+    {
+    case 1:
+        memcpy(pDst, pSrc, 1);
+        break;
+    case 2:
+        memcpy(pDst, pSrc, 2);
+        break;
+    case 4:
+        memcpy(pDst, pSrc, 4);
+        break;
+    case 8:
+        memcpy(pDst, pSrc, 8);
+        break;
+    default:
+        memcpy(pDst, pSrc, itemSize);
+        break;
+    }
+}
 
-    memcpy(&pQueueHandle->buffer[pQueueHandle->writeIndex], pItem, pQueueHandle->itemSize);
-    pQueueHandle->writeIndex = (pQueueHandle->writeIndex + pQueueHandle->itemSize) % (pQueueHandle->queueLength * pQueueHandle->itemSize);
-    pQueueHandle->itemCount++;
+/**
+ * @brief Unblock the next waiting task of the wait queue. Tasks suspended while waiting, or timed out but not run yet,
+ * are no longer blocked; they are skipped.
+ *
+ * @param pWaitQueue Pointer to the wait queue
+ * @param wakeupReason Wakeup reason of the unblocked task
+ * @retval true if the unblocked task should preempt the current task
+ * @retval false otherwise
+ */
+static bool msgQueueWakeNext(taskQueueType *pWaitQueue, wakeupReasonType wakeupReason)
+{
+    taskHandleType *pTask = NULL;
 
-    // Get next waiting consumer task to unblock
-getNextConsumer:
-    consumer = taskQueueGet(&pQueueHandle->consumerWaitQueue);
-    if (consumer != NULL)
+getNextTask:
+    pTask = taskQueueGet(pWaitQueue);
+    if (pTask != NULL)
     {
-        /*If task was suspended while waiting for Queue data, skipt the task and get another waiting task from the waitQueue*/
-        if (consumer->status == TASK_STATUS_SUSPENDED)
+        /*If task is no longer blocked, skip the task and get another waiting task from the waitQueue*/
+        if (pTask->status != TASK_STATUS_BLOCKED)
         {
-            goto getNextConsumer;
+            goto getNextTask;
         }
-        taskSetReady(consumer, MSG_QUEUE_DATA_AVAILABLE);
+        taskSetReady(pTask, wakeupReason);
 
-        /*Perform context switch if  unblocked consumer task has equal or
-         *higher priority[lower priority value] than that of current task */
-        if (consumer->priority <= taskPool.currentTask->priority)
+        /*Perform context switch if unblocked task should preempt the current task*/
+        return taskPreemptionRequired(pTask);
+    }
+
+    return false;
+}
+
+/**
+ * @brief Find the first consumer task in the waitQueue whose wait condition is satisfied by the specified number of items.
+ * Task suspended while waiting, or timed out but not run yet, is no longer blocked; it stays in the waitQueue and removes
+ * itself once it runs. Task waiting for more items does not hold up the tasks behind it.
+ *
+ * @param pQueueHandle
+ * @param itemCount Number of items available to the consumer tasks
+ * @return Pointer to the taskNode struct of the consumer task if found, NULL otherwise
+ */
+static taskNodeType *msgQueueConsumerFind(msgQueueHandleType *pQueueHandle, uint32_t itemCount)
+{
+    taskNodeType *pTaskNode = pQueueHandle->consumerWaitQueue.head;
+
+    while (pTaskNode != NULL)
+    {
+        taskHandleType *pTask = pTaskNode->pTask;
+
+        if (pTask->status == TASK_STATUS_BLOCKED && ((msgQueueReceiveWaitType *)pTask->pWaitData)->minCount <= itemCount)
         {
-            contextSwitchRequired = true;
+            break;
         }
+
+        pTaskNode = pTaskNode->nextTaskNode;
     }
 
-    EXIT_CRITICAL_SECTION();
+    return pTaskNode;
+}
 
-    if (contextSwitchRequired)
+/**
+ * @brief Unblock the first waiting consumer task whose wait condition is satisfied by the items in the queue buffer.
+ * This function must be called from within a critical section.
+ *
+ * @param pQueueHandle
+ * @retval true if the unblocked consumer task should preempt the current task
+ * @retval false otherwise
+ */
+static bool msgQueueWakeConsumer(msgQueueHandleType *pQueueHandle)
+{
+    taskNodeType *pTaskNode = msgQueueConsumerFind(pQueueHandle, pQueueHandle->itemCount);
+
+    if (pTaskNode == NULL)
     {
-        taskYield();
+        return false;
     }
+
+    taskQueueRemove(&pQueueHandle->consumerWaitQueue, pTaskNode);
+
+    taskSetReady(pTaskNode->pTask, MSG_QUEUE_DATA_AVAILABLE);
+
+    /*Perform context switch if unblocked task should preempt the current task*/
+    return taskPreemptionRequired(pTaskNode->pTask);
 }
 
 /**
- * @brief  Get an item from the queue buffer
+ * @brief Commit the item at the write index of the queue buffer and unblock the next waiting consumer task. While a slot
+ * is reserved, the item is queued behind the reserved slot and can be received only once the reserved slot is committed.
+ * This function must be called from within a critical section.
  *
  * @param pQueueHandle
- * @param pItem
+ * @retval true if the unblocked consumer task should preempt the current task
+ * @retval false otherwise
  */
-static void msgQueueBufferRead(msgQueueHandleType *pQueueHandle, void *pItem)
+static bool msgQueueCommitUnsafe(msgQueueHandleType *pQueueHandle)
 {
-    bool contextSwitchRequired = false;
+    pQueueHandle->writeIndex = msgQueueIndexNext(pQueueHandle, pQueueHandle->writeIndex);
 
-    taskHandleType *producer = NULL;
+    if (pQueueHandle->reservedSlots != 0)
+    {
+        pQueueHandle->reservedSlots++;
 
-    ENTER_CRITICAL_SECTION();
+        return false;
+    }
+
+    pQueueHandle->itemCount++;
 
-    memcpy(pItem, &pQueueHandle->buffer[pQueueHandle->readIndex], pQueueHandle->itemSize);
-    pQueueHandle->readIndex = (pQueueHandle->readIndex + pQueueHandle->itemSize) % (pQueueHandle->queueLength * pQueueHandle->itemSize);
+    // Unblock next waiting consumer task
+    return msgQueueWakeConsumer(pQueueHandle);
+}
+
+/**
+ * @brief Release the item at the read index of the queue buffer and unblock the next waiting producer task. While an
+ * item is peeked, the slot stays occupied until the peeked item, which is in front of it, is released.
+ * This function must be called from within a critical section.
+ *
+ * @param pQueueHandle
+ * @retval true if the unblocked producer task should preempt the current task
+ * @retval false otherwise
+ */
+static bool msgQueueReleaseUnsafe(msgQueueHandleType *pQueueHandle)
+{
+    pQueueHandle->readIndex = msgQueueIndexNext(pQueueHandle, pQueueHandle->readIndex);
     pQueueHandle->itemCount--;
 
-    // Get next waiting producer task to unblock
-getNextProducer:
-    producer = taskQueueGet(&pQueueHandle->producerWaitQueue);
-    if (producer != NULL)
+    if (pQueueHandle->peekedSlots != 0)
+    {
+        pQueueHandle->peekedSlots++;
+
+        return false;
+    }
+
+    // Unblock next waiting producer task
+    return msgQueueWakeNext(&pQueueHandle->producerWaitQueue, MSG_QUEUE_SPACE_AVAILABE);
+}
+
+/**
+ * @brief Insert an item to the queue buffer and unblock the next waiting consumer task. This function must be
+ * called from within a critical section.
+ *
+ * @param pQueueHandle
+ * @param pItem
+ * @retval true if the unblocked consumer task should preempt the current task
+ * @retval false otherwise
+ */
+static bool msgQueueBufferWriteUnsafe(msgQueueHandleType *pQueueHandle, void *pItem)
+{
+    msgQueueItemCopy(msgQueueSlot(pQueueHandle, pQueueHandle->writeIndex), pItem, pQueueHandle->itemSize);
+
+    return msgQueueCommitUnsafe(pQueueHandle);
+}
+
+/**
+ * @brief Get an item from the queue buffer and unblock the next waiting producer task. This function must be
+ * called from within a critical section.
+ *
+ * @param pQueueHandle
+ * @param pItem
+ * @retval true if the unblocked producer task should preempt the current task
+ * @retval false otherwise
+ */
+static bool msgQueueBufferReadUnsafe(msgQueueHandleType *pQueueHandle, void *pItem)
+{
+    msgQueueItemCopy(pItem, msgQueueSlot(pQueueHandle, pQueueHandle->readIndex), pQueueHandle->itemSize);
+
+    return msgQueueReleaseUnsafe(pQueueHandle);
+}
+
+/**
+ * @brief Copy the item directly to the destination of the highest priority consumer task waiting in msgQueueReceive and
+ * complete the receive on its behalf. This is only possible if the queue is empty and no slot is reserved; otherwise, the
+ * item must be queued behind the items in the queue buffer. This function must be called from within a critical section.
+ *
+ * @param pQueueHandle
+ * @param pItem
+ * @param pContextSwitchRequired Set to true if the unblocked consumer task should preempt the current task.
+ * @retval true if item is handed off to a waiting consumer task
+ * @retval false otherwise
+ */
+static bool msgQueueHandoffUnsafe(msgQueueHandleType *pQueueHandle, void *pItem, bool *pContextSwitchRequired)
+{
+    if (!msgQueueEmpty(pQueueHandle) || pQueueHandle->reservedSlots != 0)
+    {
+        return false;
+    }
+
+    taskNodeType *pTaskNode = msgQueueConsumerFind(pQueueHandle, 1);
+
+    /*Consumer task waiting in msgQueuePeekSlot has no destination; it consumes the item from the queue buffer*/
+    if (pTaskNode == NULL || ((msgQueueReceiveWaitType *)pTaskNode->pTask->pWaitData)->pItem == NULL)
+    {
+        return false;
+    }
+
+    taskHandleType *consumer = pTaskNode->pTask;
+
+    msgQueueItemCopy(((msgQueueReceiveWaitType *)consumer->pWaitData)->pItem, pItem, pQueueHandle->itemSize);
+
+    taskQueueRemove(&pQueueHandle->consumerWaitQueue, pTaskNode);
+
+    taskSetReady(consumer, MSG_QUEUE_DATA_RECEIVED);
+
+    *pContextSwitchRequired = taskPreemptionRequired(consumer);
+
+    return true;
+}
+
+/**
+ * @brief Wait until the queue has space for an item. This function must be called from within a critical section;
+ * the critical section is released while the task is blocked. The space may be taken by another task before the
+ * woken up task runs; hence, it may block several times and waitTicks bounds the total wait time.
+ *
+ * @param pQueueHandle
+ * @param waitTicks Number of ticks to wait if Queue is full.
+ * @retval RET_SUCCESS if Queue has space.
+ * @retval RET_FULL if Queue is full.
+ * @retval RET_TIMEOUT if wait timeout occured.
+ */
+static int msgQueueWaitForSpace(msgQueueHandleType *pQueueHandle, uint32_t waitTicks)
+{
+    taskHandleType *currentTask = taskPool.currentTask;
+
+    uint32_t startTick = osTicksGet();
+
+    uint32_t remainingTicks = waitTicks;
+
+retry:
+    if (!msgQueueFull(pQueueHandle))
     {
-        /*If task was suspended while waiting for Queue space, skip the task and get another waiting task from the wait Queue*/
-        if (producer->status == TASK_STATUS_SUSPENDED)
+        return RET_SUCCESS;
+    }
+    else if (waitTicks == TASK_NO_WAIT)
+    {
+        return RET_FULL;
+    }
+
+    /*Wait time already spent in previous iterations is deducted*/
+    if (waitTicks != TASK_MAX_WAIT)
+    {
+        uint32_t elapsedTicks = osTicksGet() - startTick;
+
+        if (elapsedTicks >= waitTicks)
         {
-            goto getNextProducer;
+            return RET_TIMEOUT;
         }
-        taskSetReady(producer, MSG_QUEUE_SPACE_AVAILABE);
 
-        /*Perform context switch if unblocked producer task has equal or
-         *higher priority[lower priority value] than that of current task */
-        if (producer->priority <= taskPool.currentTask->priority)
+        remainingTicks = waitTicks - elapsedTicks;
+    }
+
+    taskQueueAdd(&pQueueHandle->producerWaitQueue, &currentTask->waitNode);
+
+    // Block current task and  give CPU to other tasks while waiting for space to be available
+    taskBlock(currentTask, WAIT_FOR_MSG_QUEUE_SPACE, remainingTicks);
+
+    if (currentTask->wakeupReason == WAIT_TIMEOUT)
+    {
+        /*Wait timed out,remove task from wait Queue unless it has already been skipped by another task.*/
+        if (taskQueueNodeLinked(&pQueueHandle->producerWaitQueue, &currentTask->waitNode))
         {
-            contextSwitchRequired = true;
+            taskQueueRemove(&pQueueHandle->producerWaitQueue, &currentTask->waitNode);
         }
+
+        return RET_TIMEOUT;
     }
 
-    EXIT_CRITICAL_SECTION();
+    /*Space might have been taken by another task, or task might have been suspended while waiting for space
+      to be available and later resumed. In both cases, check for space again.*/
+    if (taskQueueNodeLinked(&pQueueHandle->producerWaitQueue, &currentTask->waitNode))
+    {
+        taskQueueRemove(&pQueueHandle->producerWaitQueue, &currentTask->waitNode);
+    }
 
-    if (contextSwitchRequired)
+    goto retry;
+}
+
+/**
+ * @brief Wait until the queue has at least minCount items. This function must be called from within a critical section;
+ * the critical section is released while the task is blocked. The task is woken up once the queue holds minCount items,
+ * but they may be taken by another task before it runs; hence, it may block several times and waitTicks bounds the total wait time.
+ *
+ * @param pQueueHandle
+ * @param pItem Destination of the item a producer task may copy to directly while the task is blocked. NULL if
+ * the items are to be consumed from the queue buffer. Must be NULL if minCount is greater than 1.
+ * @param minCount Minimum number of items
+ * @param waitTicks Number of ticks to wait if Queue has less than minCount items.
+ * @retval RET_SUCCESS if Queue has at least minCount items.
+ * @retval MSG_QUEUE_RECEIVED_DIRECTLY if item has been copied to pItem by a producer task.
+ * @retval RET_EMPTY if Queue has less than minCount items.
+ * @retval RET_TIMEOUT if wait timeout occured.
+ */
+static int msgQueueWaitForData(msgQueueHandleType *pQueueHandle, void *pItem, uint32_t minCount, uint32_t waitTicks)
+{
+    taskHandleType *currentTask = taskPool.currentTask;
+
+    uint32_t startTick = osTicksGet();
+
+    uint32_t remainingTicks = waitTicks;
+
+    msgQueueReceiveWaitType wait = {.pItem = pItem, .minCount = minCount};
+
+retry:
+    if (pQueueHandle->itemCount >= minCount)
     {
-        taskYield();
+        return RET_SUCCESS;
+    }
+    else if (waitTicks == TASK_NO_WAIT)
+    {
+        return RET_EMPTY;
     }
+
+    /*Wait time already spent in previous iterations is deducted*/
+    if (waitTicks != TASK_MAX_WAIT)
+    {
+        uint32_t elapsedTicks = osTicksGet() - startTick;
+
+        if (elapsedTicks >= waitTicks)
+        {
+            return RET_TIMEOUT;
+        }
+
+        remainingTicks = waitTicks - elapsedTicks;
+    }
+
+    currentTask->pWaitData = &wait;
+
+    taskQueueAdd(&pQueueHandle->consumerWaitQueue, &currentTask->waitNode);
+
+    // Block current task and give CPU to other tasks while waiting for data to be available
+    taskBlock(currentTask, WAIT_FOR_MSG_QUEUE_DATA, remainingTicks);
+
+    currentTask->pWaitData = NULL;
+
+    if (currentTask->wakeupReason == MSG_QUEUE_DATA_RECEIVED)
+    {
+        return MSG_QUEUE_RECEIVED_DIRECTLY;
+    }
+
+    if (currentTask->wakeupReason == WAIT_TIMEOUT)
+    {
+        /*Wait timed out,remove task from wait Queue unless it has already been skipped by another task.*/
+        if (taskQueueNodeLinked(&pQueueHandle->consumerWaitQueue, &currentTask->waitNode))
+        {
+            taskQueueRemove(&pQueueHandle->consumerWaitQueue, &currentTask->waitNode);
+        }
+
+        return RET_TIMEOUT;
+    }
+
+    /*Data might have been taken by another task, fewer than minCount items might be available, or task might have been
+      suspended while waiting for data to be available and later resumed. In all cases, check for data again.*/
+    if (taskQueueNodeLinked(&pQueueHandle->consumerWaitQueue, &currentTask->waitNode))
+    {
+        taskQueueRemove(&pQueueHandle->consumerWaitQueue, &currentTask->waitNode);
+    }
+
+    goto retry;
 }
 
 /**
  * @brief Send an item to the queue. If the queue if full, block the task for specified number of wait ticks.
- * If calling this function from an ISR, the parameter waitTicksshould be set to TASK_NO_WAIT.
+ * If calling this function from an ISR, use msgQueueSendFromISR instead.
  * @param pQueueHandle Pointer to queueHandle struct.
  * @param pItem Pointer to the item to be sent to the Queue.
  * @param waitTicks Number of ticks to wait if Queue is full.
@@ -141,54 +476,76 @@ int msgQueueSend(msgQueueHandleType *pQueueHandle, void *pItem, uint32_t waitTic
 
     int retCode;
 
-    /*Write to msgQueue buffer if messageQueue is not full*/
-retry:
-    if (!msgQueueFull(pQueueHandle))
-    {
-        msgQueueBufferWrite(pQueueHandle, pItem);
+    bool contextSwitchRequired = false;
 
-        retCode = RET_SUCCESS;
-    }
-    else if (waitTicks == TASK_NO_WAIT)
+    ENTER_CRITICAL_SECTION();
+
+    retCode = msgQueueWaitForSpace(pQueueHandle, waitTicks);
+
+    if (retCode == RET_SUCCESS)
     {
-        retCode = RET_FULL;
+        if (!msgQueueHandoffUnsafe(pQueueHandle, pItem, &contextSwitchRequired))
+        {
+            contextSwitchRequired = msgQueueBufferWriteUnsafe(pQueueHandle, pItem);
+        }
     }
-    else
+
+    EXIT_CRITICAL_SECTION();
+
+    if (contextSwitchRequired)
     {
-        taskHandleType *currentTask = taskPool.currentTask;
+        taskYield();
+    }
 
-        taskQueueAdd(&pQueueHandle->producerWaitQueue, currentTask);
+    return retCode;
+}
 
-        // Block current task and  give CPU to other tasks while waiting for space to be available
-        taskBlock(currentTask, WAIT_FOR_MSG_QUEUE_SPACE, waitTicks);
+/**
+ * @brief Send an item to the queue from an ISR. This function never blocks; if the unblocked consumer task
+ * should preempt the current task, context switch is performed once all pending ISRs have been serviced.
+ * @param pQueueHandle Pointer to queueHandle struct.
+ * @param pItem Pointer to the item to be sent to the Queue.
+ * @retval RET_SUCCESS if message sent successfully.
+ * @retval RET_FULL if Queue is full.
+ */
+int msgQueueSendFromISR(msgQueueHandleType *pQueueHandle, void *pItem)
+{
+    assert(pQueueHandle != NULL);
+    assert(pItem != NULL);
 
-        if (currentTask->wakeupReason == MSG_QUEUE_SPACE_AVAILABE && !msgQueueFull(pQueueHandle))
-        {
-            msgQueueBufferWrite(pQueueHandle, pItem);
+    int retCode;
 
-            retCode = RET_SUCCESS;
-        }
-        else if (currentTask->wakeupReason == WAIT_TIMEOUT)
-        {
+    bool contextSwitchRequired = false;
 
-            /*Wait timed out,remove task from wait Queue.*/
-            taskQueueRemove(&pQueueHandle->producerWaitQueue, currentTask);
+    uint32_t savedState = ENTER_CRITICAL_SECTION_FROM_ISR();
 
-            retCode = RET_TIMEOUT;
-        }
-        /*Task might have been suspended while waiting for space to be available and later resumed.
-          In this case, retry sending to the msgQueue again */
-        else
+    if (msgQueueFull(pQueueHandle))
+    {
+        retCode = RET_FULL;
+    }
+    else
+    {
+        if (!msgQueueHandoffUnsafe(pQueueHandle, pItem, &contextSwitchRequired))
         {
-            goto retry;
+            contextSwitchRequired = msgQueueBufferWriteUnsafe(pQueueHandle, pItem);
         }
+
+        retCode = RET_SUCCESS;
     }
+
+    EXIT_CRITICAL_SECTION_FROM_ISR(savedState);
+
+    if (contextSwitchRequired)
+    {
+        taskYieldFromISR();
+    }
+
     return retCode;
 }
 
 /**
  * @brief Receive an item from the queue. If the queue is empty, block the task for specified  number of wait ticks.
- * If calling this function from an ISR, the parameter waitTicks should be set to TASK_NO_WAIT.
+ * This function cannot be called from an ISR.
  * @param pQueueHandle Pointer to queueHandle struct
  * @param pItem Pointer to the variable to be assigned the data received from the Queue.
  * @param waitTicks Number of ticks to wait if Queue is empty.
@@ -203,45 +560,318 @@ int msgQueueReceive(msgQueueHandleType *pQueueHandle, void *pItem, uint32_t wait
 
     int retCode;
 
-retry:
-    if (!msgQueueEmpty(pQueueHandle))
+    bool contextSwitchRequired = false;
+
+    ENTER_CRITICAL_SECTION();
+
+    retCode = msgQueueWaitForData(pQueueHandle, pItem, 1, waitTicks);
+
+    if (retCode == MSG_QUEUE_RECEIVED_DIRECTLY)
     {
-        msgQueueBufferRead(pQueueHandle, pItem);
+        /*Item has been copied to pItem by the producer task*/
         retCode = RET_SUCCESS;
     }
-    else if (waitTicks == TASK_NO_WAIT)
+    else if (retCode == RET_SUCCESS)
     {
-        retCode = RET_EMPTY;
+        contextSwitchRequired = msgQueueBufferReadUnsafe(pQueueHandle, pItem);
     }
-    else
+
+    EXIT_CRITICAL_SECTION();
+
+    if (contextSwitchRequired)
+    {
+        taskYield();
+    }
+
+    return retCode;
+}
+
+/**
+ * @brief Send up to count items to the queue under a single critical section. If the queue is full, block the task
+ * for specified number of wait ticks until at least one item can be sent. Waiting consumer tasks are unblocked as items
+ * are sent, and context switch is performed at most once after all the items have been sent.
+ * @param pQueueHandle Pointer to queueHandle struct.
+ * @param pItems Pointer to the array of items to be sent to the Queue.
+ * @param count Number of items in the array.
+ * @param pSent Pointer to the variable to be assigned the number of items sent.
+ * @param waitTicks Number of ticks to wait if Queue is full.
+ * @retval RET_SUCCESS if at least one item is sent.
+ * @retval RET_FULL if Queue is full.
+ * @retval RET_TIMEOUT if wait timeout occured.
+ */
+int msgQueueSendN(msgQueueHandleType *pQueueHandle, const void *pItems, uint32_t count, uint32_t *pSent, uint32_t waitTicks)
+{
+    assert(pQueueHandle != NULL);
+    assert(pItems != NULL);
+    assert(pSent != NULL);
+
+    int retCode;
+
+    uint32_t sent = 0;
+
+    bool contextSwitchRequired = false;
+
+    const uint8_t *pItem = (const uint8_t *)pItems;
+
+    ENTER_CRITICAL_SECTION();
+
+    retCode = msgQueueWaitForSpace(pQueueHandle, waitTicks);
+
+    if (retCode == RET_SUCCESS)
+    {
+        while (sent < count && !msgQueueFull(pQueueHandle))
+        {
+            bool taskPreempted = false;
+
+            if (!msgQueueHandoffUnsafe(pQueueHandle, (void *)pItem, &taskPreempted))
+            {
+                taskPreempted = msgQueueBufferWriteUnsafe(pQueueHandle, (void *)pItem);
+            }
+
+            contextSwitchRequired |= taskPreempted;
+
+            pItem += pQueueHandle->itemSize;
+            sent++;
+        }
+    }
+
+    EXIT_CRITICAL_SECTION();
+
+    *pSent = sent;
+
+    if (contextSwitchRequired)
+    {
+        taskYield();
+    }
+
+    return retCode;
+}
+
+/**
+ * @brief Receive at least minCount and up to maxCount items from the queue under a single critical section. If the queue has
+ * less than minCount items, block the task for specified number of wait ticks. If the wait times out, available items are
+ * received nevertheless. Waiting producer tasks are unblocked as items are received, and context switch is performed at most
+ * once after all the items have been received. This function cannot be called from an ISR.
+ * @param pQueueHandle Pointer to queueHandle struct.
+ * @param pItems Pointer to the array to be assigned the items received from the Queue. Must hold maxCount items.
+ * @param minCount Minimum number of items to receive. Must not exceed the length of the Queue.
+ * @param maxCount Maximum number of items to receive.
+ * @param pReceived Pointer to the variable to be assigned the number of items received.
+ * @param waitTicks Number of ticks to wait if Queue has less than minCount items.
+ * @retval RET_SUCCESS if at least minCount items are received.
+ * @retval RET_EMPTY if Queue has less than minCount items.
+ * @retval RET_TIMEOUT if wait timeout occured.
+ */
+int msgQueueReceiveN(msgQueueHandleType *pQueueHandle, void *pItems, uint32_t minCount, uint32_t maxCount, uint32_t *pReceived, uint32_t waitTicks)
+{
+    assert(pQueueHandle != NULL);
+    assert(pItems != NULL);
+    assert(pReceived != NULL);
+    assert(minCount != 0 && minCount <= maxCount && minCount <= pQueueHandle->queueLength);
+
+    int retCode;
+
+    uint32_t received = 0;
+
+    bool contextSwitchRequired = false;
+
+    uint8_t *pItem = (uint8_t *)pItems;
+
+    ENTER_CRITICAL_SECTION();
+
+    retCode = msgQueueWaitForData(pQueueHandle, NULL, minCount, waitTicks);
+
+    if (retCode == RET_SUCCESS || retCode == RET_TIMEOUT)
+    {
+        while (received < maxCount && !msgQueueEmpty(pQueueHandle))
+        {
+            contextSwitchRequired |= msgQueueBufferReadUnsafe(pQueueHandle, pItem);
+
+            pItem += pQueueHandle->itemSize;
+            received++;
+        }
+    }
+
+    EXIT_CRITICAL_SECTION();
+
+    *pReceived = received;
+
+    if (contextSwitchRequired)
     {
-        taskHandleType *currentTask = taskPool.currentTask;
+        taskYield();
+    }
 
-        taskQueueAdd(&pQueueHandle->consumerWaitQueue, currentTask);
+    return retCode;
+}
+
+/**
+ * @brief Reserve the next free slot of the queue to build an item in place. If the queue is full, block the task
+ * for specified number of wait ticks. The item is sent once msgQueueCommit is called. Only one slot can be reserved
+ * at a time. Reserved slot counts as occupied; items sent meanwhile are queued behind it and can be received once
+ * the reserved slot is committed.
+ * @param pQueueHandle Pointer to queueHandle struct.
+ * @param ppSlot Pointer to the variable to be assigned the address of the reserved slot.
+ * @param waitTicks Number of ticks to wait if Queue is full.
+ * @retval RET_SUCCESS if slot reserved successfully.
+ * @retval RET_FULL if Queue is full.
+ * @retval RET_TIMEOUT if wait timeout occured.
+ * @retval RET_BUSY if a slot is already reserved.
+ */
+int msgQueueReserve(msgQueueHandleType *pQueueHandle, void **ppSlot, uint32_t waitTicks)
+{
+    assert(pQueueHandle != NULL);
+    assert(ppSlot != NULL);
 
-        // Block current task and give CPU to other tasks while waiting for data to be available
-        taskBlock(currentTask, WAIT_FOR_MSG_QUEUE_DATA, waitTicks);
+    int retCode;
 
-        if (currentTask->wakeupReason == MSG_QUEUE_DATA_AVAILABLE && !msgQueueEmpty(pQueueHandle))
+    ENTER_CRITICAL_SECTION();
+
+    retCode = msgQueueWaitForSpace(pQueueHandle, waitTicks);
+
+    if (retCode == RET_SUCCESS)
+    {
+        if (pQueueHandle->reservedSlots != 0)
+        {
+            retCode = RET_BUSY;
+        }
+        else
         {
-            msgQueueBufferRead(pQueueHandle, pItem);
+            *ppSlot = msgQueueSlot(pQueueHandle, pQueueHandle->writeIndex);
 
-            retCode = RET_SUCCESS;
+            pQueueHandle->writeIndex = msgQueueIndexNext(pQueueHandle, pQueueHandle->writeIndex);
+            pQueueHandle->reservedSlots = 1;
         }
-        else if (currentTask->wakeupReason == WAIT_TIMEOUT)
+    }
+
+    EXIT_CRITICAL_SECTION();
+
+    return retCode;
+}
+
+/**
+ * @brief Send the item built in the slot reserved by msgQueueReserve.
+ * @param pQueueHandle Pointer to queueHandle struct.
+ * @retval RET_SUCCESS if item sent successfully.
+ * @retval RET_INVAL if no slot is reserved.
+ */
+int msgQueueCommit(msgQueueHandleType *pQueueHandle)
+{
+    assert(pQueueHandle != NULL);
+
+    int retCode = RET_INVAL;
+
+    bool contextSwitchRequired = false;
+
+    ENTER_CRITICAL_SECTION();
+
+    if (pQueueHandle->reservedSlots != 0)
+    {
+        uint32_t committedItems = pQueueHandle->reservedSlots;
+
+        /*Reserved slot and the items queued behind it can be received now*/
+        pQueueHandle->itemCount += committedItems;
+        pQueueHandle->reservedSlots = 0;
+
+        while (committedItems-- != 0)
         {
+            contextSwitchRequired |= msgQueueWakeConsumer(pQueueHandle);
+        }
 
-            /*Wait timed out,remove task from wait Queue.*/
-            taskQueueRemove(&pQueueHandle->consumerWaitQueue, currentTask);
+        retCode = RET_SUCCESS;
+    }
+
+    EXIT_CRITICAL_SECTION();
 
-            retCode = RET_TIMEOUT;
+    if (contextSwitchRequired)
+    {
+        taskYield();
+    }
+
+    return retCode;
+}
+
+/**
+ * @brief Get the front item of the queue in place, without copying it. If the queue is empty, block the task for
+ * specified number of wait ticks. The item stays in the queue until msgQueueRelease is called. Only one item can be
+ * peeked at a time. Peeked item counts as occupied; other receives get the items behind it, whose slots are freed
+ * along with the peeked one once it is released.
+ * @param pQueueHandle Pointer to queueHandle struct.
+ * @param ppSlot Pointer to the variable to be assigned the address of the front item.
+ * @param waitTicks Number of ticks to wait if Queue is empty.
+ * @retval RET_SUCCESS if item peeked successfully.
+ * @retval RET_EMPTY if Queue is empty.
+ * @retval RET_TIMEOUT if wait timeout occured.
+ * @retval RET_BUSY if an item is already peeked.
+ */
+int msgQueuePeekSlot(msgQueueHandleType *pQueueHandle, void **ppSlot, uint32_t waitTicks)
+{
+    assert(pQueueHandle != NULL);
+    assert(ppSlot != NULL);
+
+    int retCode;
+
+    ENTER_CRITICAL_SECTION();
+
+    retCode = msgQueueWaitForData(pQueueHandle, NULL, 1, waitTicks);
+
+    if (retCode == RET_SUCCESS)
+    {
+        if (pQueueHandle->peekedSlots != 0)
+        {
+            retCode = RET_BUSY;
         }
-        /*Task might have been suspended while waiting for data to be available and later resumed.
-        In this case, retry receiving from the msgQueue again */
         else
         {
-            goto retry;
+            *ppSlot = msgQueueSlot(pQueueHandle, pQueueHandle->readIndex);
+
+            pQueueHandle->readIndex = msgQueueIndexNext(pQueueHandle, pQueueHandle->readIndex);
+            pQueueHandle->itemCount--;
+            pQueueHandle->peekedSlots = 1;
+        }
+    }
+
+    EXIT_CRITICAL_SECTION();
+
+    return retCode;
+}
+
+/**
+ * @brief Remove the item peeked by msgQueuePeekSlot from the queue.
+ * @param pQueueHandle Pointer to queueHandle struct.
+ * @retval RET_SUCCESS if item released successfully.
+ * @retval RET_INVAL if no item is peeked.
+ */
+int msgQueueRelease(msgQueueHandleType *pQueueHandle)
+{
+    assert(pQueueHandle != NULL);
+
+    int retCode = RET_INVAL;
+
+    bool contextSwitchRequired = false;
+
+    ENTER_CRITICAL_SECTION();
+
+    if (pQueueHandle->peekedSlots != 0)
+    {
+        uint32_t releasedSlots = pQueueHandle->peekedSlots;
+
+        /*Peeked slot and the slots of the items received behind it are free now*/
+        pQueueHandle->peekedSlots = 0;
+
+        while (releasedSlots-- != 0)
+        {
+            contextSwitchRequired |= msgQueueWakeNext(&pQueueHandle->producerWaitQueue, MSG_QUEUE_SPACE_AVAILABE);
         }
+
+        retCode = RET_SUCCESS;
     }
+
+    EXIT_CRITICAL_SECTION();
+
+    if (contextSwitchRequired)
+    {
+        taskYield();
+    }
+
     return retCode;
 }
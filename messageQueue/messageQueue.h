@@ -27,7 +27,10 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
+#include "retCodes.h"
 #include "mutex/mutex.h"
+#include "scheduler/scheduler.h"
 #include "taskQueue/taskQueue.h"
 
 #ifdef __cplusplus
@@ -52,8 +55,85 @@ extern "C"
         .queueLength = length,                    \
         .itemSize = item_size,                    \
         .itemCount = 0,                           \
+        .indexMask = 0,                           \
         .readIndex = 0,                           \
-        .writeIndex = 0}
+        .writeIndex = 0,                          \
+        .reservedSlots = 0,                       \
+        .peekedSlots = 0}
+
+/*Compile time check usable from both C and C++*/
+#ifdef __cplusplus
+#define MSG_QUEUE_STATIC_ASSERT(condition, message) static_assert(condition, message)
+#else
+#define MSG_QUEUE_STATIC_ASSERT(condition, message) _Static_assert(condition, message)
+#endif
+
+/**
+ * @brief Generate name##Send, name##SendFromISR and name##Receive for a message queue whose length is a power of two.
+ * They are static inline functions whose queue, index mask and item size are compile time constants; hence, the compiler
+ * turns the item copy into fixed size load/store instructions and masks the indices with an immediate. They take the
+ * fast path only if no task has to be unblocked and no slot is reserved, and otherwise fall back to msgQueueSend,
+ * msgQueueSendFromISR and msgQueueReceive.
+ */
+#define MSG_QUEUE_POW2_FUNCTIONS(name, length, item_size)                                    \
+    static inline __attribute__((unused)) int name##Send(void *pItem, uint32_t waitTicks)    \
+    {                                                                                        \
+        ENTER_CRITICAL_SECTION();                                                            \
+        bool sent = msgQueueSendFast(&name, pItem, (length) - 1, item_size);                 \
+        EXIT_CRITICAL_SECTION();                                                             \
+        return sent ? RET_SUCCESS : msgQueueSend(&name, pItem, waitTicks);                   \
+    }                                                                                        \
+    static inline __attribute__((unused)) int name##SendFromISR(void *pItem)                 \
+    {                                                                                        \
+        uint32_t savedState = ENTER_CRITICAL_SECTION_FROM_ISR();                             \
+        bool sent = msgQueueSendFast(&name, pItem, (length) - 1, item_size);                 \
+        EXIT_CRITICAL_SECTION_FROM_ISR(savedState);                                          \
+        return sent ? RET_SUCCESS : msgQueueSendFromISR(&name, pItem);                       \
+    }                                                                                        \
+    static inline __attribute__((unused)) int name##Receive(void *pItem, uint32_t waitTicks) \
+    {                                                                                        \
+        ENTER_CRITICAL_SECTION();                                                            \
+        bool received = msgQueueReceiveFast(&name, pItem, (length) - 1, item_size);          \
+        EXIT_CRITICAL_SECTION();                                                             \
+        return received ? RET_SUCCESS : msgQueueReceive(&name, pItem, waitTicks);            \
+    }
+
+/**
+ * @brief Statically define and initialize a message queue whose length is a power of two. Ring buffer indices are
+ * masked instead of being wrapped around, and the ring buffer is word aligned so that items of common sizes are
+ * copied with word accesses. name##Send, name##SendFromISR and name##Receive, specialized for the queue at compile time,
+ * are generated as well. Use MSG_QUEUE_DECLARE_POW2 to access them from other source files.
+ * @param name Name of the message queue.
+ * @param length Maximum number of message items the message queue can hold. Must be a power of two.
+ * @param item_size Size of a message item in bytes.
+ */
+#define MSG_QUEUE_DEFINE_POW2(name, length, item_size)                                                                 \
+    MSG_QUEUE_STATIC_ASSERT((length) != 0 && ((length) & ((length) - 1)) == 0, "Queue length must be a power of two"); \
+    uint8_t name##Buffer[length * item_size] __attribute__((aligned(4)));                                              \
+    MSG_QUEUE_DECLARE_POW2(name, length, item_size)                                                                    \
+    msgQueueHandleType name = {                                                                                        \
+        .producerWaitQueue = {0},                                                                                      \
+        .consumerWaitQueue = {0},                                                                                      \
+        .buffer = name##Buffer,                                                                                        \
+        .queueLength = length,                                                                                         \
+        .itemSize = item_size,                                                                                         \
+        .itemCount = 0,                                                                                                \
+        .indexMask = (length) - 1,                                                                                     \
+        .readIndex = 0,                                                                                                \
+        .writeIndex = 0,                                                                                               \
+        .reservedSlots = 0,                                                                                            \
+        .peekedSlots = 0}
+
+/**
+ * @brief Declare a message queue defined with MSG_QUEUE_DEFINE_POW2 in another source file, along with its
+ * name##Send, name##SendFromISR and name##Receive functions.
+ * @param name Name of the message queue.
+ * @param length Same length as passed to MSG_QUEUE_DEFINE_POW2.
+ * @param item_size Same item size as passed to MSG_QUEUE_DEFINE_POW2.
+ */
+#define MSG_QUEUE_DECLARE_POW2(name, length, item_size) \
+    extern msgQueueHandleType name;                     \
+    MSG_QUEUE_POW2_FUNCTIONS(name, length, item_size)
 
     typedef struct
     {
@@ -62,13 +142,17 @@ extern "C"
         uint8_t *buffer;
         uint32_t queueLength;
         uint32_t itemSize;
-        uint32_t itemCount;
-        uint32_t readIndex;
-        uint32_t writeIndex;
+        uint32_t itemCount;     // Number of items that can be received
+        uint32_t indexMask;     // queueLength - 1 if queueLength is a power of two, 0 otherwise
+        uint32_t readIndex;     // Slot index of the front item
+        uint32_t writeIndex;    // Slot index of the next free slot
+        uint32_t reservedSlots; // Slot reserved by msgQueueReserve and the items sent behind it, 0 if no slot is reserved
+        uint32_t peekedSlots;   // Item peeked by msgQueuePeekSlot and the items received behind it, 0 if no item is peeked
     } msgQueueHandleType;
 
     /**
-     * @brief Check if message queue is full
+     * @brief Check if message queue is full. Slots held by a reserved slot or a peeked item are occupied until
+     * they are committed or released.
      *
      * @param pQueueHandle
      * @retval true if msgQueue is full
@@ -76,7 +160,7 @@ extern "C"
      */
     static inline bool msgQueueFull(msgQueueHandleType *pQueueHandle)
     {
-        return pQueueHandle->itemCount == pQueueHandle->queueLength;
+        return pQueueHandle->itemCount + pQueueHandle->reservedSlots + pQueueHandle->peekedSlots == pQueueHandle->queueLength;
     }
 
     /**
@@ -91,10 +175,77 @@ extern "C"
         return pQueueHandle->itemCount == 0;
     }
 
+    /**
+     * @brief Copy an item to the queue buffer if no consumer task is waiting and no slot is reserved. Only the queue
+     * state is updated; hence, the function is inlined into the functions generated by MSG_QUEUE_DEFINE_POW2, where
+     * indexMask and itemSize are constants. This function must be called from within a critical section.
+     *
+     * @param pQueueHandle
+     * @param pItem Pointer to the item
+     * @param indexMask Queue length - 1
+     * @param itemSize Size of an item in bytes
+     * @retval true if item is copied
+     * @retval false if the item must be sent with msgQueueSend
+     */
+    static inline bool msgQueueSendFast(msgQueueHandleType *pQueueHandle, const void *pItem, uint32_t indexMask, uint32_t itemSize)
+    {
+        if (msgQueueFull(pQueueHandle) || pQueueHandle->reservedSlots != 0 || !taskQueueEmpty(&pQueueHandle->consumerWaitQueue))
+        {
+            return false;
+        }
+
+        memcpy(&pQueueHandle->buffer[pQueueHandle->writeIndex * itemSize], pItem, itemSize);
+
+        pQueueHandle->writeIndex = (pQueueHandle->writeIndex + 1) & indexMask;
+        pQueueHandle->itemCount++;
+
+        return true;
+    }
+
+    /**
+     * @brief Copy the front item from the queue buffer if no producer task is waiting and no item is peeked.
+     * Counterpart of msgQueueSendFast. This function must be called from within a critical section.
+     *
+     * @param pQueueHandle
+     * @param pItem Pointer to the variable to be assigned the item
+     * @param indexMask Queue length - 1
+     * @param itemSize Size of an item in bytes
+     * @retval true if item is copied
+     * @retval false if the item must be received with msgQueueReceive
+     */
+    static inline bool msgQueueReceiveFast(msgQueueHandleType *pQueueHandle, void *pItem, uint32_t indexMask, uint32_t itemSize)
+    {
+        if (msgQueueEmpty(pQueueHandle) || pQueueHandle->peekedSlots != 0 || !taskQueueEmpty(&pQueueHandle->producerWaitQueue))
+        {
+            return false;
+        }
+
+        memcpy(pItem, &pQueueHandle->buffer[pQueueHandle->readIndex * itemSize], itemSize);
+
+        pQueueHandle->readIndex = (pQueueHandle->readIndex + 1) & indexMask;
+        pQueueHandle->itemCount--;
+
+        return true;
+    }
+
     int msgQueueSend(msgQueueHandleType *pQueueHandle, void *pItem, uint32_t waitTicks);
 
+    int msgQueueSendFromISR(msgQueueHandleType *pQueueHandle, void *pItem);
+
     int msgQueueReceive(msgQueueHandleType *pQueueHandle, void *pItem, uint32_t waitTicks);
 
+    int msgQueueSendN(msgQueueHandleType *pQueueHandle, const void *pItems, uint32_t count, uint32_t *pSent, uint32_t waitTicks);
+
+    int msgQueueReceiveN(msgQueueHandleType *pQueueHandle, void *pItems, uint32_t minCount, uint32_t maxCount, uint32_t *pReceived, uint32_t waitTicks);
+
+    int msgQueueReserve(msgQueueHandleType *pQueueHandle, void **ppSlot, uint32_t waitTicks);
+
+    int msgQueueCommit(msgQueueHandleType *pQueueHandle);
+
+    int msgQueuePeekSlot(msgQueueHandleType *pQueueHandle, void **ppSlot, uint32_t waitTicks);
+
+    int msgQueueRelease(msgQueueHandleType *pQueueHandle);
+
 #ifdef __cplusplus
 }
 #endif
@@ -60,7 +60,7 @@ retry:
         {
             pMutex->ownerDefaultPriority = pMutex->ownerTask->priority;
         }
-        pMutex->ownerTask->priority = currentTask->priority;
+        taskSetPriority(pMutex->ownerTask, currentTask->priority);
     }
 #endif
     /* Check if mutex is free and no owner has been assigned. If so, lock mutex immediately.*/
@@ -80,25 +80,23 @@ retry:
     else
     {
         /* Add the tasking waiting on mutex to the wait queue*/
-        taskQueueAdd(&pMutex->waitQueue, currentTask);
+        taskQueueAdd(&pMutex->waitQueue, &currentTask->waitNode);
 
-        /*Exit from critical section before blocking the task*/
-        EXIT_CRITICAL_SECTION();
-
-        /* Block current task and give CPU to other tasks while waiting for mutex*/
+        /* Block current task and give CPU to other tasks while waiting for mutex. Critical section is held until the
+           task is blocked; otherwise, mutex could be handed over to the task before it is blocked.*/
         taskBlock(currentTask, WAIT_FOR_MUTEX, waitTicks);
 
-        /*Re-enter critical section after being unblocked*/
-        ENTER_CRITICAL_SECTION();
-
         if (currentTask->wakeupReason == MUTEX_LOCKED && pMutex->ownerTask == currentTask)
         {
             retCode = RET_SUCCESS;
         }
         else if (currentTask->wakeupReason == WAIT_TIMEOUT)
         {
-            /*Wait timed out, remove task from  the waitQueue.*/
-            taskQueueRemove(&pMutex->waitQueue, currentTask);
+            /*Wait timed out, remove task from  the waitQueue unless it has already been skipped by mutexUnlock.*/
+            if (taskQueueNodeLinked(&pMutex->waitQueue, &currentTask->waitNode))
+            {
+                taskQueueRemove(&pMutex->waitQueue, &currentTask->waitNode);
+            }
 
             retCode = RET_TIMEOUT;
         }
@@ -106,6 +104,12 @@ retry:
           In this case, retry locking the mutex again */
         else
         {
+            /*Task node is still linked in the waitQueue if the task was not picked while it was suspended*/
+            if (taskQueueNodeLinked(&pMutex->waitQueue, &currentTask->waitNode))
+            {
+                taskQueueRemove(&pMutex->waitQueue, &currentTask->waitNode);
+            }
+
             goto retry;
         }
     }
@@ -149,7 +153,7 @@ int mutexUnlock(mutexHandleType *pMutex)
             /* Assign owner task its default priority if priority inheritance was perforemd while locking the mutex*/
             if (pMutex->ownerDefaultPriority != -1)
             {
-                pMutex->ownerTask->priority = pMutex->ownerDefaultPriority;
+                taskSetPriority(pMutex->ownerTask, pMutex->ownerDefaultPriority);
 
                 /* Reset owner defalult priority of mutex*/
                 pMutex->ownerDefaultPriority = -1;
@@ -161,17 +165,17 @@ int mutexUnlock(mutexHandleType *pMutex)
 
             if (nextOwner != NULL)
             {
-                /*If task was suspended while waiting for mutex,skip the task and get another waiting task from the waitQueue*/
-                if (nextOwner->status == TASK_STATUS_SUSPENDED)
+                /*If task was suspended while waiting for mutex, or timed out but has not run yet, it is no longer blocked;
+                  skip the task and get another waiting task from the waitQueue*/
+                if (nextOwner->status != TASK_STATUS_BLOCKED)
                 {
                     goto getNextOwner;
                 }
 
                 taskSetReady(nextOwner, MUTEX_LOCKED);
 
-                /*Perform context switch if next owner task has equal or
-                 *higher priority[lower priority value] than that of current task */
-                if (nextOwner->priority <= taskPool.currentTask->priority)
+                /*Perform context switch if next owner task should preempt the current task*/
+                if (taskPreemptionRequired(nextOwner))
                 {
                     contextSwitchRequired = true;
                 }
@@ -50,8 +50,37 @@ extern "C"
 
 #define MUTEX_USE_PRIORITY_INHERITANCE 1
 
+/*Highest interrupt priority[lowest priority value] masked by kernel critical sections. Interrupts with a lower priority
+value are never delayed by the kernel but must not call any kernel API. Must be greater than 0. Ignored on ARMv6-M,
+where critical sections mask all interrupts.*/
+#define KERNEL_MAX_SYSCALL_PRIORITY 5
+
+/*Tasks defined with a priority of TASK_PRIORITY_LEVELS or higher fail to compile. Set to 256 to keep the full
+  0 to 255 priority range at the cost of a larger ready queue.*/
+#define TASK_PRIORITY_LEVELS 32 // Number of task priority levels[0 to TASK_PRIORITY_LEVELS - 1]. Maximum 256.
+
 #define OS_TICK_INTERVAL_US 1000 // Generate SysTick interrupt every 1ms.
 
+#define TASK_PREEMPT_ON_EQUAL_PRIORITY 0 // Whether a woken up task preempts the running task of equal priority immediately.
+
+#define TASK_TIME_SLICE_TICKS 10 // Default number of ticks a task runs before tasks of equal priority get CPU. 0 disables time slicing.
+
+#define OS_TICKLESS_IDLE 0 // Suppress SysTick interrupts and sleep while idle task runs. Requires TASK_RUN_PRIVILEGED.
+
+#define OS_TICKLESS_MIN_IDLE_TICKS 2 // Minimum number of idle ticks for which tick suppression is worthwhile.
+
+#define OS_TICK_SOURCE_SIM 0 // Use simulated tick source for the tickless idle mode to run on a host.
+
+#define OS_HR_TIMER 0 // Use a hardware counter with a compare channel for timeouts shorter than a tick.
+
+#define OS_HR_TIMER_FREQUENCY_HZ 1000000 // Frequency of the high resolution counter.
+
+#define OS_HR_TIMER_SIM 0 // Use simulated high resolution counter to run on a host.
+
+#define TIMER_WHEEL_SLOT_BITS 5 // Each level of the software timer wheel has 2^TIMER_WHEEL_SLOT_BITS slots.
+
+#define TIMER_WHEEL_LEVELS 4 // Number of levels of the software timer wheel.
+
 #define MS_TO_CPU_TICKS(ms) ((uint32_t)((uint64_t)ms * SystemCoreClock / 1000))
 #define US_TO_CPU_TICKS(us) ((uint32_t)((uint64_t)us * SystemCoreClock / 1000000))
 
@@ -61,6 +90,9 @@ extern "C"
 #define US_TO_OS_TICKS(us) ((uint32_t)(US_TO_CPU_TICKS(us) / OS_INTERVAL_CPU_TICKS))
 #define MS_TO_OS_TICKS(ms) ((uint32_t)(MS_TO_CPU_TICKS(ms) / OS_INTERVAL_CPU_TICKS))
 
+#define OS_TICKS_TO_US(ticks) ((uint64_t)(ticks) * OS_TICK_INTERVAL_US)
+#define OS_TICKS_TO_MS(ticks) ((uint64_t)(ticks) * OS_TICK_INTERVAL_US / 1000)
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,142 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <assert.h>
+#include "osConfig.h"
+#include "task/task.h"
+#include "taskQueue/taskQueue.h"
+#include "readyQueue.h"
+
+/**
+ * @brief Mark priority level as non-empty in the bitmaps
+ *
+ * @param pReadyQueue Pointer to the readyQueue struct
+ * @param priority Priority level
+ */
+static inline void readyQueueBitmapSet(readyQueueType *pReadyQueue, uint8_t priority)
+{
+    pReadyQueue->bitmap[priority >> 5] |= (0x80000000UL >> (priority & 0x1f));
+    pReadyQueue->groupBitmap |= (0x80000000UL >> (priority >> 5));
+}
+
+/**
+ * @brief Mark priority level as empty in the bitmaps
+ *
+ * @param pReadyQueue Pointer to the readyQueue struct
+ * @param priority Priority level
+ */
+static inline void readyQueueBitmapClear(readyQueueType *pReadyQueue, uint8_t priority)
+{
+    pReadyQueue->bitmap[priority >> 5] &= ~(0x80000000UL >> (priority & 0x1f));
+
+    if (pReadyQueue->bitmap[priority >> 5] == 0)
+    {
+        pReadyQueue->groupBitmap &= ~(0x80000000UL >> (priority >> 5));
+    }
+}
+
+/**
+ * @brief Add task to the back of the FIFO of its priority level
+ *
+ * @param pReadyQueue Pointer to the readyQueue struct
+ * @param pTask Pointer to the taskHandle struct
+ */
+void readyQueueAdd(readyQueueType *pReadyQueue, taskHandleType *pTask)
+{
+    assert(pReadyQueue != NULL);
+    assert(pTask != NULL);
+    assert(pTask->priority < TASK_PRIORITY_LEVELS);
+    assert(!taskQueueNodeLinked(&pReadyQueue->level[pTask->priority], &pTask->schedNode));
+
+    taskQueueAddToBack(&pReadyQueue->level[pTask->priority], &pTask->schedNode);
+
+    readyQueueBitmapSet(pReadyQueue, pTask->priority);
+}
+
+/**
+ * @brief Add task to the front of the FIFO of its priority level, e.g. when a running task is preempted
+ * and should resume before other tasks of its priority level.
+ *
+ * @param pReadyQueue Pointer to the readyQueue struct
+ * @param pTask Pointer to the taskHandle struct
+ */
+void readyQueueAddToFront(readyQueueType *pReadyQueue, taskHandleType *pTask)
+{
+    assert(pReadyQueue != NULL);
+    assert(pTask != NULL);
+    assert(pTask->priority < TASK_PRIORITY_LEVELS);
+    assert(!taskQueueNodeLinked(&pReadyQueue->level[pTask->priority], &pTask->schedNode));
+
+    taskQueueAddToFront(&pReadyQueue->level[pTask->priority], &pTask->schedNode);
+
+    readyQueueBitmapSet(pReadyQueue, pTask->priority);
+}
+
+/**
+ * @brief Get the highest priority task from the readyQueue. This corresponds to the front task of the
+ * highest priority non-empty level.
+ * @param pReadyQueue Pointer to the readyQueue struct
+ * @retval Next highest priority task if exists
+ * @retval NULL if readyQueue is empty
+ */
+taskHandleType *readyQueueGet(readyQueueType *pReadyQueue)
+{
+    assert(pReadyQueue != NULL);
+
+    if (!readyQueueEmpty(pReadyQueue))
+    {
+        uint8_t priority = readyQueueHighestPriority(pReadyQueue);
+
+        taskHandleType *pTask = taskQueueGet(&pReadyQueue->level[priority]);
+
+        if (taskQueueEmpty(&pReadyQueue->level[priority]))
+        {
+            readyQueueBitmapClear(pReadyQueue, priority);
+        }
+
+        return pTask;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Remove task from the readyQueue
+ *
+ * @param pReadyQueue Pointer to the readyQueue struct
+ * @param pTask Pointer to the taskHandle struct
+ */
+void readyQueueRemove(readyQueueType *pReadyQueue, taskHandleType *pTask)
+{
+    assert(pReadyQueue != NULL);
+    assert(pTask != NULL);
+
+    taskQueueRemove(&pReadyQueue->level[pTask->priority], &pTask->schedNode);
+
+    if (taskQueueEmpty(&pReadyQueue->level[pTask->priority]))
+    {
+        readyQueueBitmapClear(pReadyQueue, pTask->priority);
+    }
+}
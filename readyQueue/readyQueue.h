@@ -0,0 +1,104 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __SANO_RTOS_READY_QUEUE_H
+#define __SANO_RTOS_READY_QUEUE_H
+
+#include "osConfig.h"
+#include "taskQueue/taskQueue.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#if (TASK_PRIORITY_LEVELS < 1) || (TASK_PRIORITY_LEVELS > 256)
+#error "TASK_PRIORITY_LEVELS must be in the range 1 to 256"
+#endif
+
+/*Number of 32-bit words required to hold one bit per priority level*/
+#define READY_QUEUE_BITMAP_WORDS ((TASK_PRIORITY_LEVELS + 31) / 32)
+
+    /**
+     * @brief Queue of ready tasks. Each priority level has its own FIFO of tasks, and a two level bitmap
+     * keeps track of non-empty levels. Bit (31 - n) of groupBitmap is set if bitmap[n] is non-zero, and bit
+     * (31 - priority % 32) of bitmap[priority / 32] is set if the FIFO of that priority is non-empty.
+     * The highest priority[lowest priority value] non-empty level is therefore found with two CLZ instructions.
+     */
+    typedef struct
+    {
+        uint32_t groupBitmap;
+        uint32_t bitmap[READY_QUEUE_BITMAP_WORDS];
+        taskQueueType level[TASK_PRIORITY_LEVELS];
+    } readyQueueType;
+
+    void readyQueueAdd(readyQueueType *pReadyQueue, taskHandleType *pTask);
+
+    void readyQueueAddToFront(readyQueueType *pReadyQueue, taskHandleType *pTask);
+
+    taskHandleType *readyQueueGet(readyQueueType *pReadyQueue);
+
+    void readyQueueRemove(readyQueueType *pReadyQueue, taskHandleType *pTask);
+
+    /**
+     * @brief Check if readyQueue is empty
+     *
+     * @param pReadyQueue
+     * @retval true if readyQueue is empty
+     * @retval false, otherwise
+     */
+    static inline bool readyQueueEmpty(readyQueueType *pReadyQueue)
+    {
+        return pReadyQueue->groupBitmap == 0;
+    }
+
+    /**
+     * @brief Get the highest priority[lowest priority value] among the ready tasks. readyQueue must not be empty.
+     *
+     * @param pReadyQueue Pointer to the readyQueue struct
+     * @return Highest priority of the ready tasks
+     */
+    static inline uint8_t readyQueueHighestPriority(readyQueueType *pReadyQueue)
+    {
+        uint32_t word = __CLZ(pReadyQueue->groupBitmap);
+
+        return (uint8_t)((word << 5) + __CLZ(pReadyQueue->bitmap[word]));
+    }
+
+    /**
+     * @brief Get the highest priority ready task without removing it from the readyQueue. readyQueue must not be empty.
+     *
+     * @param pReadyQueue Pointer to the readyQueue struct
+     * @return Pointer to taskHandle struct of the highest priority ready task
+     */
+    static inline taskHandleType *readyQueuePeek(readyQueueType *pReadyQueue)
+    {
+        return taskQueuePeek(&pReadyQueue->level[readyQueueHighestPriority(pReadyQueue)]);
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
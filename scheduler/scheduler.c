@@ -23,21 +23,97 @@
  */
 
 #include <stdlib.h>
+#include <assert.h>
 #include "osConfig.h"
 #include "task/task.h"
 #include "timer/timer.h"
 #include "taskQueue/taskQueue.h"
+#include "readyQueue/readyQueue.h"
+#include "tickSource/tickSource.h"
+#include "hrTimer/hrTimer.h"
 #include "scheduler.h"
 
 #define IDLE_TASK_PRIORITY TASK_LOWEST_PRIORITY // Idle task has lowest possible priority[higher the value lower the priority]
 
+#if (OS_TICKLESS_IDLE) && !(TASK_RUN_PRIVILEGED)
+#error "OS_TICKLESS_IDLE requires TASK_RUN_PRIVILEGED"
+#endif
+
 TASK_DEFINE(idleTask, 192, idleTaskHandler, NULL, IDLE_TASK_PRIORITY);
 
+volatile uint32_t criticalNesting = 0;
+
+/*Number of ticks elapsed since the scheduler was started. 64-bit counter never wraps around in practice.*/
+static volatile uint64_t tickCount = 0;
+
+/*Nesting depth of scheduler locks*/
+static volatile uint32_t schedulerLockNesting = 0;
+
+/*Set if context switch was required while the scheduler was locked*/
+static volatile bool contextSwitchPending = false;
+
+/*Set if the context switch deferred while the scheduler was locked gives CPU to tasks of equal priority as well*/
+static volatile bool pendingYieldToEqualPriority = false;
+
+static void scheduleNextTask(bool yieldToEqualPriority);
+
+static void processTicks(uint32_t elapsedTicks);
+
+#if OS_TICKLESS_IDLE
+/**
+ * @brief Get number of ticks until the earliest timeout of blocked tasks and running timers.
+ *
+ * @return Number of ticks the tick interrupt can be suppressed for
+ */
+static uint32_t idleTicksGet()
+{
+    uint32_t idleTicks = timerNextExpiryTicks();
+
+    if (!taskQueueEmpty(&taskPool.blockedQueue) && taskQueuePeek(&taskPool.blockedQueue)->remainingSleepTicks < idleTicks)
+    {
+        idleTicks = taskQueuePeek(&taskPool.blockedQueue)->remainingSleepTicks;
+    }
+
+    return idleTicks;
+}
+
+/**
+ * @brief Suppress tick interrupts until the earliest timeout and sleep. Elapsed ticks are
+ * accounted on wakeup.
+ */
+static void idleSuppressTicks()
+{
+    /*PRIMASK is used instead of the kernel critical section since WFI must be woken up by masked interrupts.*/
+    __disable_irq();
+
+    if (readyQueueEmpty(&taskPool.readyQueue))
+    {
+        uint32_t idleTicks = idleTicksGet();
+
+        if (idleTicks >= OS_TICKLESS_MIN_IDLE_TICKS && tickSourceSuppress(idleTicks))
+        {
+            tickSourceWaitForInterrupt();
+
+            processTicks(tickSourceResume());
+
+            /*Switch to the tasks woken up by the elapsed ticks*/
+            scheduleNextTask(true);
+        }
+    }
+
+    __enable_irq();
+}
+#endif
+
 void idleTaskHandler(void *params)
 {
     (void)params;
     while (1)
-        ;
+    {
+#if OS_TICKLESS_IDLE
+        idleSuppressTicks();
+#endif
+    }
 }
 /**
  * @brief Trigger PendSV interrupt
@@ -50,26 +126,29 @@ static inline void triggerPendSV()
 
 /**
  * @brief Select next highest priority ready task for execution and trigger PendSV to perform actual context switch.
+ * The task whose context is saved (currentTask) is updated by PendSV itself; hence, calling this function
+ * several times before PendSV runs only changes the task switched to and results in a single context switch.
+ * @param yieldToEqualPriority If true, the running task gives CPU to ready tasks of equal priority as well;
+ * otherwise, it is preempted by higher priority tasks only.
  */
-static void scheduleNextTask()
+static void scheduleNextTask(bool yieldToEqualPriority)
 {
-    if (!taskQueueEmpty(&taskPool.readyQueue))
+    if (!readyQueueEmpty(&taskPool.readyQueue))
     {
+        bool preempted = false;
 
         if (taskPool.currentTask->status == TASK_STATUS_RUNNING)
         {
-            /*Perform context switch only if next highest priority ready task has equal or higher priority[lower priority value]
-            than the current running task*/
+            /*Perform context switch only if next highest priority ready task has higher priority[lower priority value]
+            than the current running task, or equal priority if requested*/
 
-            taskHandleType *nextReadyTask = taskQueuePeek(&taskPool.readyQueue);
+            taskHandleType *nextReadyTask = readyQueuePeek(&taskPool.readyQueue);
 
-            if (nextReadyTask->priority <= taskPool.currentTask->priority)
+            if (nextReadyTask->priority < taskPool.currentTask->priority)
             {
-                /*Change current task's status to ready and add it to the readyQueue*/
-                taskPool.currentTask->status = TASK_STATUS_READY;
-                taskQueueAdd(&taskPool.readyQueue, taskPool.currentTask);
+                preempted = true;
             }
-            else
+            else if (nextReadyTask->priority != taskPool.currentTask->priority || !yieldToEqualPriority)
             {
                 /*Current running task has higher priority than the next highest priority ready task;Hence, no need to perform context
                   switch. Return from here */
@@ -77,10 +156,37 @@ static void scheduleNextTask()
             }
         }
 
-        currentTask = taskPool.currentTask;
+        /*Current task must not be preempted while the scheduler is locked. Record the context switch to
+          perform it once the scheduler is unlocked.*/
+        if (schedulerLockNesting != 0)
+        {
+            contextSwitchPending = true;
+
+            if (!preempted)
+            {
+                pendingYieldToEqualPriority = true;
+            }
+            return;
+        }
+
+        if (taskPool.currentTask->status == TASK_STATUS_RUNNING)
+        {
+            taskPool.currentTask->status = TASK_STATUS_READY;
+
+            if (preempted)
+            {
+                /*Preempted task resumes before other tasks of its priority level with the rest of its time slice*/
+                readyQueueAddToFront(&taskPool.readyQueue, taskPool.currentTask);
+            }
+            else
+            {
+                /*Add current task behind other tasks of its priority level*/
+                readyQueueAdd(&taskPool.readyQueue, taskPool.currentTask);
+            }
+        }
 
         // Get the next highest priority  ready task
-        nextTask = taskQueueGet(&taskPool.readyQueue);
+        nextTask = readyQueueGet(&taskPool.readyQueue);
 
         taskPool.currentTask = nextTask;
 
@@ -93,32 +199,197 @@ static void scheduleNextTask()
 
 /**
  * @brief Check for timeout of blocked tasks and change  status to READY
- * with corresponding timeout reason.
+ * with corresponding timeout reason. Since blockedQueue is sorted by timeout and stores
+ * remainingSleepTicks as delta, only the front tasks are visited.
+ * @param elapsedTicks Number of ticks elapsed since the previous check
  */
-static void checkTimeout()
+static void checkTimeout(uint32_t elapsedTicks)
 {
-
-    taskNodeType *currentTaskNode = taskPool.blockedQueue.head;
-
-    while (currentTaskNode != NULL)
+    while (!taskQueueEmpty(&taskPool.blockedQueue))
     {
-        /*Save next task node to avoid losing track of linked list after task node
-         is freed while setting corresponding task to READY */
-        taskNodeType *nextTaskNode = currentTaskNode->nextTaskNode;
+        taskHandleType *pTask = taskQueuePeek(&taskPool.blockedQueue);
 
-        if (currentTaskNode->pTask->remainingSleepTicks > 0)
+        if (pTask->remainingSleepTicks > elapsedTicks)
         {
-            currentTaskNode->pTask->remainingSleepTicks--;
-            if (currentTaskNode->pTask->remainingSleepTicks == 0)
-            {
-                if (currentTaskNode->pTask->blockedReason == SLEEP)
-                    taskSetReady(currentTaskNode->pTask, SLEEP_TIME_TIMEOUT);
-                else
-                    taskSetReady(currentTaskNode->pTask, WAIT_TIMEOUT);
-            }
+            pTask->remainingSleepTicks -= elapsedTicks;
+            break;
         }
-        currentTaskNode = nextTaskNode;
+
+        /*Task times out within the elapsed ticks. Following tasks time out relative to it.*/
+        elapsedTicks -= pTask->remainingSleepTicks;
+        pTask->remainingSleepTicks = 0;
+
+        if (pTask->blockedReason == SLEEP)
+            taskSetReady(pTask, SLEEP_TIME_TIMEOUT);
+        else
+            taskSetReady(pTask, WAIT_TIMEOUT);
+    }
+}
+
+/**
+ * @brief Account elapsed ticks for running timers and blocked tasks.
+ *
+ * @param elapsedTicks Number of ticks elapsed
+ */
+static void processTicks(uint32_t elapsedTicks)
+{
+    if (elapsedTicks == 0)
+    {
+        return;
+    }
+
+    tickCount += elapsedTicks;
+
+    /*Check for timer timeout*/
+    processTimers(elapsedTicks);
+
+    /*Check for wait timeout of blocked tasks*/
+    checkTimeout(elapsedTicks);
+}
+
+/**
+ * @brief Get number of ticks elapsed since the scheduler was started. Ticks elapsed while the tick interrupt
+ * was suppressed are accounted as well.
+ *
+ * @return Tick count
+ */
+uint64_t osTicksGet64()
+{
+    uint64_t ticks;
+
+    /*64-bit counter cannot be read atomically*/
+    ENTER_CRITICAL_SECTION();
+
+    ticks = tickCount;
+
+    EXIT_CRITICAL_SECTION();
+
+    return ticks;
+}
+
+/**
+ * @brief Get lower 32 bits of the number of ticks elapsed since the scheduler was started. The value wraps around;
+ * hence, differences of tick counts must be computed with unsigned arithmetic.
+ *
+ * @return Tick count
+ */
+uint32_t osTicksGet()
+{
+    return (uint32_t)tickCount;
+}
+
+/**
+ * @brief Read the number of microseconds elapsed since the scheduler was started. Time elapsed since the last tick
+ * is read from the SysTick current value register, which is only accessible in privileged mode.
+ * SysTick must count down from OS_INTERVAL_CPU_TICKS - 1 at every tick, as programmed by SYSTICK_CONFIG. On STM32,
+ * where SysTick is configured by the HAL, its period must match OS_TICK_INTERVAL_US; otherwise, the time elapsed
+ * since the last tick cannot be derived and only whole ticks are counted.
+ *
+ * @return Uptime in microseconds
+ */
+static uint64_t uptimeUsRead()
+{
+    uint64_t ticks;
+
+    uint32_t currentValue;
+
+    uint32_t savedState = ENTER_CRITICAL_SECTION_FROM_ISR();
+
+    ticks = tickCount;
+
+    currentValue = SysTick->VAL;
+
+    /*SysTick has reached zero but the tick is not accounted yet. Current value is read again since it may
+      have been reloaded after the first read.*/
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+    {
+        ticks++;
+
+        currentValue = SysTick->VAL;
+    }
+
+    EXIT_CRITICAL_SECTION_FROM_ISR(savedState);
+
+    /*Current value beyond the tick period means SysTick is configured with a different period*/
+    assert(currentValue < OS_INTERVAL_CPU_TICKS);
+
+    /*SysTick counts down to zero at every tick boundary*/
+    uint32_t cyclesSinceTick = (currentValue < OS_INTERVAL_CPU_TICKS) ? (OS_INTERVAL_CPU_TICKS - 1 - currentValue) : 0;
+
+    return OS_TICKS_TO_US(ticks) + (uint64_t)cyclesSinceTick * 1000000 / SystemCoreClock;
+}
+
+#if !(TASK_RUN_PRIVILEGED)
+/**
+ * @brief Get uptime through SVC. The SVC handler reads it on behalf of the unprivileged task and returns it
+ * in R0 and R1.
+ *
+ * @return Uptime in microseconds
+ */
+static inline uint64_t uptimeUsSyscall()
+{
+    register uint32_t low __asm("r0");
+    register uint32_t high __asm("r1");
+
+    __asm volatile("svc %2" : "=r"(low), "=r"(high) : "I"(GET_UPTIME_US) : "memory");
+
+    return ((uint64_t)high << 32) | low;
+}
+#endif
+
+/**
+ * @brief Get number of microseconds elapsed since the scheduler was started, with sub-tick precision.
+ * Unprivileged tasks get it through SVC, since SysTick registers are not accessible to them.
+ *
+ * @return Uptime in microseconds
+ */
+uint64_t osUptimeUs()
+{
+#if !(TASK_RUN_PRIVILEGED)
+    /*ISRs run in privileged mode and read the registers directly*/
+    if (__get_IPSR() == 0)
+    {
+        return uptimeUsSyscall();
     }
+#endif
+
+    return uptimeUsRead();
+}
+
+/**
+ * @brief Account a tick to the time slice of the running task.
+ *
+ * @retval true if time slice of the running task has expired
+ * @retval false otherwise
+ */
+static bool timeSliceTick()
+{
+    taskHandleType *pTask = taskPool.currentTask;
+
+    if (pTask->timeSliceTicks == 0 || --pTask->remainingTimeSliceTicks != 0)
+    {
+        return false;
+    }
+
+    /*Start next time slice. The task keeps running if no task of equal priority is ready.*/
+    pTask->remainingTimeSliceTicks = pTask->timeSliceTicks;
+
+    return true;
+}
+
+/**
+ * @brief Perform the context switch deferred while the scheduler was locked. Tasks of equal priority get CPU
+ * only if a deferred request would have given it to them. This function must be called from within a critical section.
+ */
+static void schedulePendingTask()
+{
+    bool yieldToEqualPriority = pendingYieldToEqualPriority;
+
+    contextSwitchPending = false;
+
+    pendingYieldToEqualPriority = false;
+
+    scheduleNextTask(yieldToEqualPriority);
 }
 
 /**
@@ -128,11 +399,11 @@ void taskYield()
 {
 #if (TASK_RUN_PRIVILEGED)
 
-    __disable_irq();
+    ENTER_CRITICAL_SECTION();
 
-    scheduleNextTask();
+    scheduleNextTask(true);
 
-    __enable_irq();
+    EXIT_CRITICAL_SECTION();
 
 #else
     /*We need to be in privileged mode to trigger PendSV interrupt, We can use SVC call
@@ -142,6 +413,71 @@ void taskYield()
 #endif
 }
 
+/**
+ * @brief Lock the scheduler to prevent the current task from being preempted by other tasks. Unlike critical sections,
+ * interrupts are not masked. Scheduler locks can be nested. The task must not block while the scheduler is locked.
+ */
+void schedulerLock()
+{
+    schedulerLockNesting++;
+}
+
+/**
+ * @brief Unlock the scheduler. Context switch that was required while the scheduler was locked is performed
+ * when the outermost lock is released.
+ */
+void schedulerUnlock()
+{
+    bool contextSwitchRequired;
+
+    ENTER_CRITICAL_SECTION();
+
+    assert(schedulerLockNesting != 0);
+
+    contextSwitchRequired = (--schedulerLockNesting == 0 && contextSwitchPending);
+
+#if (TASK_RUN_PRIVILEGED)
+    if (contextSwitchRequired)
+    {
+        schedulePendingTask();
+    }
+#endif
+
+    EXIT_CRITICAL_SECTION();
+
+#if !(TASK_RUN_PRIVILEGED)
+    /*PendSV can only be triggered in privileged mode; hence, the deferred context switch is performed by SVC handler*/
+    if (contextSwitchRequired)
+    {
+        SYSCALL(PENDING_CONTEXT_SWITCH);
+    }
+#endif
+}
+
+/**
+ * @brief Check if the scheduler is locked.
+ *
+ * @retval true if the scheduler is locked
+ * @retval false otherwise
+ */
+bool schedulerIsLocked()
+{
+    return schedulerLockNesting != 0;
+}
+
+/**
+ * @brief Request a context switch from an ISR. The context switch is performed by PendSV once all pending
+ * ISRs have been serviced; hence, requests from several ISRs are merged into a single context switch.
+ */
+void taskYieldFromISR()
+{
+    uint32_t savedState = ENTER_CRITICAL_SECTION_FROM_ISR();
+
+    scheduleNextTask(true);
+
+    EXIT_CRITICAL_SECTION_FROM_ISR(savedState);
+}
+
 /**
  * @brief Function to start the RTOS task scheduler.
  */
@@ -162,8 +498,13 @@ void schedulerStart()
     /* Configure SysTick to generate interrupt every OS_INTERVAL_CPU_TICKS */
     SYSTICK_CONFIG();
 
+#if OS_HR_TIMER
+    /* Initialize the high resolution counter*/
+    hrTimerInit();
+#endif
+
     /*Get the highest priority ready task from ready Queue*/
-    currentTask = taskPool.currentTask = taskQueueGet(&taskPool.readyQueue);
+    currentTask = taskPool.currentTask = readyQueueGet(&taskPool.readyQueue);
 
     /*Change status to RUNNING*/
     currentTask->status = TASK_STATUS_RUNNING;
@@ -186,21 +527,15 @@ void schedulerStart()
  */
 void SYSTICK_HANDLER()
 {
-    __disable_irq();
+    uint32_t savedState = ENTER_CRITICAL_SECTION_FROM_ISR();
 
-    /*Check for timer timeout*/
-    processTimers();
+    processTicks(1);
 
-    /*Check for wait timeout of blocked tasks*/
-    if (!taskQueueEmpty(&taskPool.blockedQueue))
-    {
-        checkTimeout();
-    }
+    /*Perform context switch if required. Tasks of equal priority get CPU only once the time slice of the
+      running task has expired.*/
+    scheduleNextTask(timeSliceTick());
 
-    /*Perform context switch if required*/
-    scheduleNextTask();
-
-    __enable_irq();
+    EXIT_CRITICAL_SECTION_FROM_ISR(savedState);
 }
 
 /**
@@ -235,16 +570,32 @@ void SVC_Handler()
     switch (svcNumber)
     {
     case DISABLE_INTERRUPTS:
-        /*Disable all the interrupts with priority values 1 or higher*/
-        __set_BASEPRI(1);
+        /*Mask all the interrupts with priority values KERNEL_MAX_SYSCALL_PRIORITY or higher*/
+        kernelInterruptsMask();
         break;
     case ENABLE_INTERUPPTS:
-        /*Enable all the interrupts*/
-        __set_BASEPRI(0);
+        /*Unmask all the interrupts*/
+        kernelInterruptsUnmask();
         break;
     case CONTEXT_SWITCH:
         /*Perform context switch if required*/
-        scheduleNextTask();
+        scheduleNextTask(true);
+        break;
+    case GET_UPTIME_US:
+    {
+        /*Return uptime in R0 and R1 of the exception stack frame, which are restored on exception return*/
+        uint64_t uptime = uptimeUsRead();
+
+        stackPointer[0] = (uint32_t)uptime;
+        stackPointer[1] = (uint32_t)(uptime >> 32);
+        break;
+    }
+    case PENDING_CONTEXT_SWITCH:
+        /*Perform context switch deferred while the scheduler was locked*/
+        if (schedulerLockNesting == 0 && contextSwitchPending)
+        {
+            schedulePendingTask();
+        }
         break;
     default:
         break;
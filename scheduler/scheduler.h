@@ -40,20 +40,163 @@ extern "C"
         DISABLE_INTERRUPTS = 1,
         ENABLE_INTERUPPTS,
         CONTEXT_SWITCH,
+        PENDING_CONTEXT_SWITCH,
+        GET_UPTIME_US,
 
     } sysCodesType;
 
 /*Macro to invoke System call. This triggers SVC exception with specified sysCode*/
 #define SYSCALL(sysCode) __asm volatile("svc %0" : : "I"(sysCode) : "memory");
 
+#if (KERNEL_MAX_SYSCALL_PRIORITY) == 0
+#error "KERNEL_MAX_SYSCALL_PRIORITY must be greater than 0"
+#endif
+
+#if !(TASK_RUN_PRIVILEGED) && defined(__ARM_ARCH_6M__)
+#error "Unprivileged tasks are not supported on ARMv6-M"
+#endif
+
+/*Use BASEPRI to mask interrupts up to KERNEL_MAX_SYSCALL_PRIORITY if supported by the core, otherwise use PRIMASK*/
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+#define KERNEL_USE_BASEPRI 1
+#else
+#define KERNEL_USE_BASEPRI 0
+#endif
+
+/*BASEPRI value to mask interrupts with priority value KERNEL_MAX_SYSCALL_PRIORITY or higher*/
+#define KERNEL_MAX_SYSCALL_BASEPRI ((KERNEL_MAX_SYSCALL_PRIORITY) << (8 - __NVIC_PRIO_BITS))
+
+    /*Nesting depth of kernel critical sections*/
+    extern volatile uint32_t criticalNesting;
+
+    /**
+     * @brief Mask interrupts that are allowed to call kernel APIs. Must be executed in privileged mode.
+     */
+    static inline void kernelInterruptsMask()
+    {
+#if KERNEL_USE_BASEPRI
+        __set_BASEPRI(KERNEL_MAX_SYSCALL_BASEPRI);
+        __ISB();
+#else
+        __disable_irq();
+#endif
+    }
+
+    /**
+     * @brief Unmask all interrupts. Must be executed in privileged mode.
+     */
+    static inline void kernelInterruptsUnmask()
+    {
+#if KERNEL_USE_BASEPRI
+        __set_BASEPRI(0);
+#else
+        __enable_irq();
+#endif
+    }
+
 #if (TASK_RUN_PRIVILEGED)
-#define ENTER_CRITICAL_SECTION() __disable_irq()
-#define EXIT_CRITICAL_SECTION() __enable_irq()
+#define KERNEL_INTERRUPTS_MASK() kernelInterruptsMask()
+#define KERNEL_INTERRUPTS_UNMASK() kernelInterruptsUnmask()
 #else
-#define ENTER_CRITICAL_SECTION() SYSCALL(DISABLE_INTERRUPTS)
-#define EXIT_CRITICAL_SECTION() SYSCALL(ENABLE_INTERUPPTS)
+#define KERNEL_INTERRUPTS_MASK() SYSCALL(DISABLE_INTERRUPTS)
+#define KERNEL_INTERRUPTS_UNMASK() SYSCALL(ENABLE_INTERUPPTS)
 #endif
 
+    /**
+     * @brief Enter critical section. Critical sections can be nested; interrupts are unmasked only
+     * when the outermost critical section is exited.
+     */
+    static inline void criticalSectionEnter()
+    {
+        KERNEL_INTERRUPTS_MASK();
+
+        criticalNesting++;
+    }
+
+    /**
+     * @brief Exit critical section.
+     */
+    static inline void criticalSectionExit()
+    {
+        if (--criticalNesting == 0)
+        {
+            KERNEL_INTERRUPTS_UNMASK();
+        }
+    }
+
+    /**
+     * @brief Exit all nested critical sections, e.g. before a task blocks.
+     *
+     * @return Nesting depth to be restored with criticalSectionRestore
+     */
+    static inline uint32_t criticalSectionRelease()
+    {
+        uint32_t nesting = criticalNesting;
+
+        criticalNesting = 0;
+
+        KERNEL_INTERRUPTS_UNMASK();
+
+        return nesting;
+    }
+
+    /**
+     * @brief Re-enter critical sections exited by criticalSectionRelease.
+     *
+     * @param nesting Nesting depth returned by criticalSectionRelease
+     */
+    static inline void criticalSectionRestore(uint32_t nesting)
+    {
+        KERNEL_INTERRUPTS_MASK();
+
+        criticalNesting = nesting;
+    }
+
+#define ENTER_CRITICAL_SECTION() criticalSectionEnter()
+#define EXIT_CRITICAL_SECTION() criticalSectionExit()
+
+    /**
+     * @brief Enter critical section from an ISR. Since an ISR may interrupt a critical section, the interrupt
+     * mask is saved to be restored on exit.
+     *
+     * @return Interrupt mask prior to entering the critical section
+     */
+    static inline uint32_t criticalSectionEnterFromISR()
+    {
+#if KERNEL_USE_BASEPRI
+        uint32_t savedState = __get_BASEPRI();
+
+        __set_BASEPRI_MAX(KERNEL_MAX_SYSCALL_BASEPRI);
+        __ISB();
+#else
+        uint32_t savedState = __get_PRIMASK();
+
+        __disable_irq();
+#endif
+        criticalNesting++;
+
+        return savedState;
+    }
+
+    /**
+     * @brief Exit critical section entered from an ISR.
+     *
+     * @param savedState Interrupt mask returned by criticalSectionEnterFromISR
+     */
+    static inline void criticalSectionExitFromISR(uint32_t savedState)
+    {
+        criticalNesting--;
+
+#if KERNEL_USE_BASEPRI
+        __set_BASEPRI(savedState);
+#else
+        __set_PRIMASK(savedState);
+#endif
+    }
+
+#define ENTER_CRITICAL_SECTION_FROM_ISR() criticalSectionEnterFromISR()
+#define EXIT_CRITICAL_SECTION_FROM_ISR(savedState) criticalSectionExitFromISR(savedState)
+
 #ifdef PLATFORM_STM32
 #define SYSTICK_HANDLER osSysTick_Handler
 /*For STM32 SoCs, SysTick timer is initialized during ClockConfig stage.
@@ -69,6 +212,20 @@ extern "C"
 
     void taskYield();
 
+    void taskYieldFromISR();
+
+    uint32_t osTicksGet();
+
+    uint64_t osTicksGet64();
+
+    uint64_t osUptimeUs();
+
+    void schedulerLock();
+
+    void schedulerUnlock();
+
+    bool schedulerIsLocked();
+
 #ifdef __cplusplus
 }
 #endif
@@ -65,25 +65,23 @@ retry:
 
         /*Put current task in semaphore's wait queue*/
 
-        taskQueueAdd(&pSem->waitQueue, currentTask);
+        taskQueueAdd(&pSem->waitQueue, &currentTask->waitNode);
 
-        /*Exit from critical section before blocking the task*/
-        EXIT_CRITICAL_SECTION();
-
-        /* Block current task and give CPU to other tasks while waiting for semaphore*/
+        /* Block current task and give CPU to other tasks while waiting for semaphore. Critical section is held until the
+           task is blocked; otherwise, semaphore could be given to the task before it is blocked.*/
         taskBlock(currentTask, WAIT_FOR_SEMAPHORE, waitTicks);
 
-        /*Re-enter critical section after being unblocked*/
-        ENTER_CRITICAL_SECTION();
-
         if (currentTask->wakeupReason == SEMAPHORE_TAKEN)
         {
             retCode = RET_SUCCESS;
         }
         else if (currentTask->wakeupReason == WAIT_TIMEOUT)
         {
-            /*Wait timed out,remove task from  the waitQueue.*/
-            taskQueueRemove(&pSem->waitQueue, currentTask);
+            /*Wait timed out,remove task from  the waitQueue unless it has already been skipped by semaphoreGive.*/
+            if (taskQueueNodeLinked(&pSem->waitQueue, &currentTask->waitNode))
+            {
+                taskQueueRemove(&pSem->waitQueue, &currentTask->waitNode);
+            }
 
             /*Wait timed out*/
             retCode = RET_TIMEOUT;
@@ -92,6 +90,12 @@ retry:
           In this case, retry taking the semaphore again */
         else
         {
+            /*Task node is still linked in the waitQueue if the task was not picked while it was suspended*/
+            if (taskQueueNodeLinked(&pSem->waitQueue, &currentTask->waitNode))
+            {
+                taskQueueRemove(&pSem->waitQueue, &currentTask->waitNode);
+            }
+
             goto retry;
         }
     }
@@ -101,57 +105,68 @@ retry:
 }
 
 /**
- * @brief Function to give/signal semaphore
+ * @brief Give semaphore to the highest priority waiting task or increment the count if no task is waiting.
+ * This function must be called from within a critical section.
  * @param pSem  pointer to the semaphoreHandle struct.
+ * @param pContextSwitchRequired Set to true if the unblocked task should preempt the current task.
  * @retval RET_SUCCESS if semaphore give succesfully.
  * @retval RET_NOSEM no semaphore available to give
  */
-int semaphoreGive(semaphoreHandleType *pSem)
+static int semaphoreGiveUnsafe(semaphoreHandleType *pSem, bool *pContextSwitchRequired)
 {
-    assert(pSem != NULL);
-
-    int retCode;
-
-    bool contextSwitchRequired = false;
-
     taskHandleType *nextTask = NULL;
 
-    ENTER_CRITICAL_SECTION();
-
-    if (pSem->count != pSem->maxCount)
+    if (pSem->count == pSem->maxCount)
     {
-        /*Get next highest priority task to unblock from the wait Queue*/
-    getNextTask:
-        nextTask = taskQueueGet(&pSem->waitQueue);
+        return RET_NOSEM;
+    }
 
-        if (nextTask != NULL)
-        {
-            /*If task was suspended while waiting for Semaphore, skip the task and get another waiting task from the waitQueue.*/
-            if (nextTask->status == TASK_STATUS_SUSPENDED)
-            {
-                goto getNextTask;
-            }
-            taskSetReady(nextTask, SEMAPHORE_TAKEN);
+    /*Get next highest priority task to unblock from the wait Queue*/
+getNextTask:
+    nextTask = taskQueueGet(&pSem->waitQueue);
 
-            /*Perform context switch if unblocked task has equal or
-             *higher priority[lower priority value] than that of current task */
-            if (nextTask->priority <= taskPool.currentTask->priority)
-            {
-                contextSwitchRequired = true;
-            }
-        }
-        else
+    if (nextTask != NULL)
+    {
+        /*If task was suspended while waiting for Semaphore, or timed out but has not run yet, it is no longer blocked;
+          skip the task and get another waiting task from the waitQueue.*/
+        if (nextTask->status != TASK_STATUS_BLOCKED)
         {
-            pSem->count++;
+            goto getNextTask;
         }
+        taskSetReady(nextTask, SEMAPHORE_TAKEN);
 
-        retCode = RET_SUCCESS;
+        /*Perform context switch if unblocked task should preempt the current task*/
+        if (taskPreemptionRequired(nextTask))
+        {
+            *pContextSwitchRequired = true;
+        }
     }
     else
     {
-        retCode = RET_NOSEM;
+        pSem->count++;
     }
 
+    return RET_SUCCESS;
+}
+
+/**
+ * @brief Function to give/signal semaphore
+ * @param pSem  pointer to the semaphoreHandle struct.
+ * @retval RET_SUCCESS if semaphore give succesfully.
+ * @retval RET_NOSEM no semaphore available to give
+ */
+int semaphoreGive(semaphoreHandleType *pSem)
+{
+    assert(pSem != NULL);
+
+    int retCode;
+
+    bool contextSwitchRequired = false;
+
+    ENTER_CRITICAL_SECTION();
+
+    retCode = semaphoreGiveUnsafe(pSem, &contextSwitchRequired);
+
     EXIT_CRITICAL_SECTION();
 
     if (contextSwitchRequired)
@@ -161,3 +176,32 @@ int semaphoreGive(semaphoreHandleType *pSem)
 
     return retCode;
 }
+
+/**
+ * @brief Function to give/signal semaphore from an ISR. This function never blocks; if the unblocked task
+ * should preempt the current task, context switch is performed once all pending ISRs have been serviced.
+ * @param pSem  pointer to the semaphoreHandle struct.
+ * @retval RET_SUCCESS if semaphore give succesfully.
+ * @retval RET_NOSEM no semaphore available to give
+ */
+int semaphoreGiveFromISR(semaphoreHandleType *pSem)
+{
+    assert(pSem != NULL);
+
+    int retCode;
+
+    bool contextSwitchRequired = false;
+
+    uint32_t savedState = ENTER_CRITICAL_SECTION_FROM_ISR();
+
+    retCode = semaphoreGiveUnsafe(pSem, &contextSwitchRequired);
+
+    EXIT_CRITICAL_SECTION_FROM_ISR(savedState);
+
+    if (contextSwitchRequired)
+    {
+        taskYieldFromISR();
+    }
+
+    return retCode;
+}
@@ -59,6 +59,8 @@ extern "C"
 
     int semaphoreGive(semaphoreHandleType *pSem);
 
+    int semaphoreGiveFromISR(semaphoreHandleType *pSem);
+
 #ifdef __cplusplus
 }
 #endif
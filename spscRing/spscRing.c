@@ -0,0 +1,228 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include <assert.h>
+#include "retCodes.h"
+#include "task/task.h"
+#include "scheduler/scheduler.h"
+#include "spscRing.h"
+
+/**
+ * @brief Copy item to the head slot and publish it to the consumer. Only the producer calls this function.
+ *
+ * @param pRing Pointer to spscRing struct
+ * @param pItem Pointer to the item
+ * @retval true if item is pushed
+ * @retval false if ring is full
+ */
+static inline bool spscRingPublish(spscRingType *pRing, const void *pItem)
+{
+    uint32_t head = pRing->head;
+
+    if (head - pRing->tail > pRing->indexMask)
+    {
+        return false;
+    }
+
+    memcpy(&pRing->buffer[(head & pRing->indexMask) * pRing->itemSize], pItem, pRing->itemSize);
+
+    /*Item must be written before it is published*/
+    __DMB();
+
+    pRing->head = head + 1;
+
+    /*Head must be written before consumerWaiting is read; pairs with the barrier in spscRingPop*/
+    __DMB();
+
+    return true;
+}
+
+/**
+ * @brief Wake up the consumer task if it is still blocked on the ring. Must be called from within a critical section.
+ *
+ * @param pRing Pointer to spscRing struct
+ * @retval true if the consumer task should preempt the current task
+ * @retval false otherwise
+ */
+static bool spscRingWakeUnsafe(spscRingType *pRing)
+{
+    taskHandleType *pTask = pRing->consumerTask;
+
+    /*Consumer task might have timed out, or been suspended, before consumerWaiting is cleared*/
+    if (pTask->status != TASK_STATUS_BLOCKED || pTask->blockedReason != WAIT_FOR_SPSC_RING_ITEM)
+    {
+        return false;
+    }
+
+    taskSetReady(pTask, SPSC_RING_ITEM_PUSHED);
+
+    return taskPreemptionRequired(pTask);
+}
+
+/**
+ * @brief Push an item to the ring from an ISR. Pushing is wait-free unless the consumer task is blocked on the
+ * empty ring, in which case it is woken up.
+ *
+ * @param pRing Pointer to spscRing struct
+ * @param pItem Pointer to the item
+ * @retval RET_SUCCESS if item is pushed
+ * @retval RET_FULL if ring is full
+ */
+int spscRingPushFromISR(spscRingType *pRing, const void *pItem)
+{
+    assert(pRing != NULL);
+    assert(pItem != NULL);
+
+    if (!spscRingPublish(pRing, pItem))
+    {
+        return RET_FULL;
+    }
+
+    if (pRing->consumerWaiting)
+    {
+        uint32_t savedState = ENTER_CRITICAL_SECTION_FROM_ISR();
+
+        bool contextSwitchRequired = spscRingWakeUnsafe(pRing);
+
+        EXIT_CRITICAL_SECTION_FROM_ISR(savedState);
+
+        if (contextSwitchRequired)
+        {
+            taskYieldFromISR();
+        }
+    }
+
+    return RET_SUCCESS;
+}
+
+/**
+ * @brief Push an item to the ring from a task. The ring never blocks the producer.
+ *
+ * @param pRing Pointer to spscRing struct
+ * @param pItem Pointer to the item
+ * @retval RET_SUCCESS if item is pushed
+ * @retval RET_FULL if ring is full
+ */
+int spscRingPush(spscRingType *pRing, const void *pItem)
+{
+    assert(pRing != NULL);
+    assert(pItem != NULL);
+
+    if (!spscRingPublish(pRing, pItem))
+    {
+        return RET_FULL;
+    }
+
+    if (pRing->consumerWaiting)
+    {
+        ENTER_CRITICAL_SECTION();
+
+        bool contextSwitchRequired = spscRingWakeUnsafe(pRing);
+
+        EXIT_CRITICAL_SECTION();
+
+        if (contextSwitchRequired)
+        {
+            taskYield();
+        }
+    }
+
+    return RET_SUCCESS;
+}
+
+/**
+ * @brief Pop an item from the ring. If the ring is empty, block the task for specified number of wait ticks.
+ * Only one task may pop from the ring. This function cannot be called from an ISR.
+ *
+ * @param pRing Pointer to spscRing struct
+ * @param pItem Pointer to the variable to be assigned the item
+ * @param waitTicks Number of ticks to wait if ring is empty
+ * @retval RET_SUCCESS if item is popped
+ * @retval RET_EMPTY if ring is empty
+ * @retval RET_TIMEOUT if timeout occured while waiting for an item
+ */
+int spscRingPop(spscRingType *pRing, void *pItem, uint32_t waitTicks)
+{
+    assert(pRing != NULL);
+    assert(pItem != NULL);
+
+    uint32_t tail = pRing->tail;
+
+    uint32_t startTick = osTicksGet();
+
+    while (pRing->head == tail)
+    {
+        uint32_t remainingTicks = waitTicks;
+
+        if (waitTicks == TASK_NO_WAIT)
+        {
+            return RET_EMPTY;
+        }
+
+        /*Wait time already spent in previous iterations is deducted*/
+        if (waitTicks != TASK_MAX_WAIT)
+        {
+            uint32_t elapsedTicks = osTicksGet() - startTick;
+
+            if (elapsedTicks >= waitTicks)
+            {
+                return RET_TIMEOUT;
+            }
+
+            remainingTicks = waitTicks - elapsedTicks;
+        }
+
+        ENTER_CRITICAL_SECTION();
+
+        pRing->consumerTask = taskPool.currentTask;
+        pRing->consumerWaiting = true;
+
+        /*consumerWaiting must be written before head is read again; pairs with the barrier in spscRingPublish.
+          Either the producer sees consumerWaiting and wakes the task up once it is blocked, or the item is seen here.
+          Producer cannot wake the task up before it is blocked, since the critical section is held until then.*/
+        __DMB();
+
+        if (pRing->head == tail)
+        {
+            taskBlock(pRing->consumerTask, WAIT_FOR_SPSC_RING_ITEM, remainingTicks);
+        }
+
+        pRing->consumerWaiting = false;
+
+        EXIT_CRITICAL_SECTION();
+    }
+
+    /*Item must not be read before it is published*/
+    __DMB();
+
+    memcpy(pItem, &pRing->buffer[(tail & pRing->indexMask) * pRing->itemSize], pRing->itemSize);
+
+    /*Item must be read before its slot is released to the producer*/
+    __DMB();
+
+    pRing->tail = tail + 1;
+
+    return RET_SUCCESS;
+}
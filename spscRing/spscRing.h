@@ -0,0 +1,90 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __SANO_RTOS_SPSC_RING_H
+#define __SANO_RTOS_SPSC_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "osConfig.h"
+#include "task/task.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Statically define and initialize a single producer single consumer ring. Producer and consumer each update
+ * only their own index; hence, items are pushed without any critical section unless the consumer task is blocked on
+ * the empty ring.
+ * @param name Name of the ring.
+ * @param length Maximum number of items the ring can hold. Must be a power of two.
+ * @param item_size Size of an item in bytes.
+ */
+#define SPSC_RING_DEFINE(name, length, item_size)                                                            \
+    _Static_assert((length) != 0 && ((length) & ((length) - 1)) == 0, "Ring length must be a power of two"); \
+    uint8_t name##Buffer[length * item_size] __attribute__((aligned(4)));                                    \
+    spscRingType name = {                                                                                    \
+        .buffer = name##Buffer,                                                                              \
+        .indexMask = (length) - 1,                                                                           \
+        .itemSize = item_size,                                                                               \
+        .head = 0,                                                                                           \
+        .tail = 0,                                                                                           \
+        .consumerTask = NULL,                                                                                \
+        .consumerWaiting = false}
+
+    typedef struct
+    {
+        uint8_t *buffer;
+        uint32_t indexMask;
+        uint32_t itemSize;
+        volatile uint32_t head;                // Number of items pushed. Written by the producer only
+        volatile uint32_t tail;                // Number of items popped. Written by the consumer only
+        taskHandleType *volatile consumerTask; // Consumer task to wake up
+        volatile bool consumerWaiting;         // Set by the consumer task while it is blocked on an empty ring
+    } spscRingType;
+
+    /**
+     * @brief Get number of items in the ring
+     *
+     * @param pRing Pointer to spscRing struct
+     * @return Number of items
+     */
+    static inline uint32_t spscRingCount(spscRingType *pRing)
+    {
+        return pRing->head - pRing->tail;
+    }
+
+    int spscRingPushFromISR(spscRingType *pRing, const void *pItem);
+
+    int spscRingPush(spscRingType *pRing, const void *pItem);
+
+    int spscRingPop(spscRingType *pRing, void *pItem, uint32_t waitTicks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -27,6 +27,7 @@
 #include "osConfig.h"
 #include "scheduler/scheduler.h"
 #include "taskQueue/taskQueue.h"
+#include "readyQueue/readyQueue.h"
 #include "task.h"
 
 taskPoolType taskPool = {0};
@@ -52,49 +53,65 @@ void taskSetReady(taskHandleType *pTask, wakeupReasonType wakeupReason)
 {
     assert(pTask != NULL);
 
-    if (pTask->status == TASK_STATUS_BLOCKED)
+    if (pTask->status == TASK_STATUS_BLOCKED && taskQueueNodeLinked(&taskPool.blockedQueue, &pTask->schedNode))
     {
         /* Remove  task from the queue of blocked tasks*/
-        taskQueueRemove(&taskPool.blockedQueue, pTask);
+        taskQueueRemoveDelta(&taskPool.blockedQueue, &pTask->schedNode);
     }
     pTask->status = TASK_STATUS_READY;
     pTask->blockedReason = BLOCK_REASON_NONE;
     pTask->wakeupReason = wakeupReason;
     pTask->remainingSleepTicks = 0;
 
+    /*Woken up task starts with a full time slice*/
+    pTask->remainingTimeSliceTicks = pTask->timeSliceTicks;
+
     /* Add task to queue of ready tasks*/
-    taskQueueAdd(&taskPool.readyQueue, pTask);
+    readyQueueAdd(&taskPool.readyQueue, pTask);
 }
 
 /**
  * @brief Block task with the specified blocking reason and number to ticks to block the task for.
+ * If called from within a critical section, the critical section is re-entered once the task is woken up.
  *
  * @param pTask Pointer to taskHandle struct.
  * @param blockReason Block reason
- * @param ticks Number to ticks to block the task for.
+ * @param ticks Number to ticks to block the task for. Pass TASK_MAX_WAIT to block the task until it is woken up explicitly.
  */
 void taskBlock(taskHandleType *pTask, blockedReasonType blockedReason, uint32_t ticks)
 {
     assert(pTask != NULL);
 
+    /*Task cannot give CPU to other tasks while the scheduler is locked*/
+    assert(!schedulerIsLocked());
+
     ENTER_CRITICAL_SECTION();
 
-    pTask->remainingSleepTicks = ticks;
     pTask->status = TASK_STATUS_BLOCKED;
     pTask->blockedReason = blockedReason;
     pTask->wakeupReason = WAKEUP_REASON_NONE;
 
-    // Add task to queue of blocked tasks. We dont need to sort tasks in blockedQueue
-    taskQueueAddToFront(&taskPool.blockedQueue, pTask);
+    /* Add task to queue of blocked tasks sorted by timeout. Task blocked for 0 ticks or TASK_MAX_WAIT ticks never times out;
+       hence, it is kept off the blockedQueue and costs nothing on every tick*/
+    if (ticks != 0 && ticks != TASK_MAX_WAIT)
+    {
+        taskQueueAddDelta(&taskPool.blockedQueue, &pTask->schedNode, ticks);
+    }
 
-    EXIT_CRITICAL_SECTION();
+    /*Critical sections entered by the caller are released while the task is blocked; otherwise, context switch
+      would be deferred until the caller exits them. They are re-entered once the task is woken up.*/
+    uint32_t savedNesting = criticalSectionRelease();
 
     // Give CPU to other tasks
     taskYield();
+
+    criticalSectionRestore(savedNesting);
+
+    EXIT_CRITICAL_SECTION();
 }
 
 /**
- * @brief Suspend task
+ * @brief Suspend task. A task cannot suspend itself while the scheduler is locked.
  *
  * @param pTask Pointer to taskHandle struct.
  */
@@ -102,17 +119,20 @@ void taskSuspend(taskHandleType *pTask)
 {
     assert(pTask != NULL);
 
+    /*Self suspended task cannot give CPU to other tasks while the scheduler is locked*/
+    assert(pTask != taskPool.currentTask || !schedulerIsLocked());
+
     ENTER_CRITICAL_SECTION();
 
     /* If task status is ready, remove it from the readyQueue*/
     if (pTask->status == TASK_STATUS_READY)
     {
-        taskQueueRemove(&taskPool.readyQueue, pTask);
+        readyQueueRemove(&taskPool.readyQueue, pTask);
     }
     /*If task status is blocked, remove it from the blockedQueue*/
-    else if (pTask->status == TASK_STATUS_BLOCKED)
+    else if (pTask->status == TASK_STATUS_BLOCKED && taskQueueNodeLinked(&taskPool.blockedQueue, &pTask->schedNode))
     {
-        taskQueueRemove(&taskPool.blockedQueue, pTask);
+        taskQueueRemoveDelta(&taskPool.blockedQueue, &pTask->schedNode);
     }
 
     pTask->remainingSleepTicks = 0;
@@ -148,3 +168,270 @@ int taskResume(taskHandleType *pTask)
 
     return RET_NOTSUSPENDED;
 }
+
+/**
+ * @brief Resume suspended task from an ISR. If the resumed task should preempt the current task,
+ * context switch is performed once all pending ISRs have been serviced.
+ *
+ * @param pTask Pointer to taskHandle struct
+ * @retval RET_SUCCESS if task is resumed
+ * @retval RET_NOTSUSPENDED if task is not suspended
+ */
+int taskResumeFromISR(taskHandleType *pTask)
+{
+    assert(pTask != NULL);
+
+    int retCode = RET_NOTSUSPENDED;
+
+    bool contextSwitchRequired = false;
+
+    uint32_t savedState = ENTER_CRITICAL_SECTION_FROM_ISR();
+
+    if (pTask->status == TASK_STATUS_SUSPENDED)
+    {
+        taskSetReady(pTask, RESUME);
+
+        contextSwitchRequired = taskPreemptionRequired(pTask);
+
+        retCode = RET_SUCCESS;
+    }
+
+    EXIT_CRITICAL_SECTION_FROM_ISR(savedState);
+
+    if (contextSwitchRequired)
+    {
+        taskYieldFromISR();
+    }
+
+    return retCode;
+}
+
+/**
+ * @brief Block task until periodTicks after the previous wakeup tick. Since the wakeup tick is advanced by exactly
+ * periodTicks on every call, execution time and preemption delay of the task do not accumulate as drift.
+ * If the wakeup tick has already passed, the function returns without blocking.
+ *
+ * @param pLastWakeTick Pointer to the previous wakeup tick. Initialize it with osTicksGet() before the first call. It is
+ * updated with the new wakeup tick.
+ * @param periodTicks Period in ticks
+ */
+void taskSleepUntil(uint32_t *pLastWakeTick, uint32_t periodTicks)
+{
+    assert(pLastWakeTick != NULL);
+
+    ENTER_CRITICAL_SECTION();
+
+    uint32_t now = osTicksGet();
+
+    /*Unsigned arithmetic handles wrap around of the tick counter*/
+    uint32_t elapsedTicks = now - *pLastWakeTick;
+
+    *pLastWakeTick += periodTicks;
+
+    if (elapsedTicks < periodTicks)
+    {
+        taskBlock(taskPool.currentTask, SLEEP, periodTicks - elapsedTicks);
+    }
+
+    EXIT_CRITICAL_SECTION();
+}
+
+/**
+ * @brief Change priority of the task. Since ready tasks are queued by their priority, a ready task is
+ * moved to the queue of its new priority level. This function must be called from within a critical section.
+ *
+ * @param pTask Pointer to taskHandle struct
+ * @param priority New priority of the task
+ */
+void taskSetPriority(taskHandleType *pTask, uint8_t priority)
+{
+    assert(pTask != NULL);
+    assert(priority < TASK_PRIORITY_LEVELS);
+
+    if (pTask->status == TASK_STATUS_READY)
+    {
+        readyQueueRemove(&taskPool.readyQueue, pTask);
+
+        pTask->priority = priority;
+
+        readyQueueAdd(&taskPool.readyQueue, pTask);
+    }
+    else
+    {
+        pTask->priority = priority;
+    }
+}
+
+/**
+ * @brief Set the time slice of the task. Once the task has run for its time slice, ready tasks of equal
+ * priority get CPU.
+ *
+ * @param pTask Pointer to taskHandle struct
+ * @param timeSliceTicks Number of ticks in the time slice. Pass 0 to never preempt the task in favour of tasks of equal priority.
+ */
+void taskSetTimeSlice(taskHandleType *pTask, uint32_t timeSliceTicks)
+{
+    assert(pTask != NULL);
+
+    ENTER_CRITICAL_SECTION();
+
+    pTask->timeSliceTicks = timeSliceTicks;
+    pTask->remainingTimeSliceTicks = timeSliceTicks;
+
+    EXIT_CRITICAL_SECTION();
+}
+
+/**
+ * @brief Update notification value of the task and wake it up if it is waiting for a notification.
+ * This function must be called from within a critical section.
+ *
+ * @param pTask Pointer to taskHandle struct of the notified task
+ * @param value Value used by the action
+ * @param action Action performed on the notification value
+ * @retval true if the woken up task should preempt the current task
+ * @retval false otherwise
+ */
+static bool taskNotifyUnsafe(taskHandleType *pTask, uint32_t value, taskNotifyActionType action)
+{
+    switch (action)
+    {
+    case TASK_NOTIFY_SET_BITS:
+        pTask->notifyValue |= value;
+        break;
+    case TASK_NOTIFY_INCREMENT:
+        pTask->notifyValue++;
+        break;
+    case TASK_NOTIFY_OVERWRITE:
+        pTask->notifyValue = value;
+        break;
+    default:
+        break;
+    }
+
+    pTask->notifyPending = true;
+
+    /*Waiting task is woken up directly; no wait queue is involved*/
+    if (pTask->status == TASK_STATUS_BLOCKED && pTask->blockedReason == WAIT_FOR_NOTIFICATION)
+    {
+        taskSetReady(pTask, NOTIFICATION_RECEIVED);
+
+        return taskPreemptionRequired(pTask);
+    }
+
+    return false;
+}
+
+/**
+ * @brief Notify task. Notification is a lightweight alternative to a semaphore or an event group
+ * when there is a single receiving task.
+ *
+ * @param pTask Pointer to taskHandle struct of the notified task
+ * @param value Bits to set for TASK_NOTIFY_SET_BITS or new value for TASK_NOTIFY_OVERWRITE. Ignored for TASK_NOTIFY_INCREMENT.
+ * @param action Action performed on the notification value
+ * @retval RET_SUCCESS if task is notified
+ */
+int taskNotify(taskHandleType *pTask, uint32_t value, taskNotifyActionType action)
+{
+    assert(pTask != NULL);
+
+    bool contextSwitchRequired;
+
+    ENTER_CRITICAL_SECTION();
+
+    contextSwitchRequired = taskNotifyUnsafe(pTask, value, action);
+
+    EXIT_CRITICAL_SECTION();
+
+    if (contextSwitchRequired)
+    {
+        taskYield();
+    }
+
+    return RET_SUCCESS;
+}
+
+/**
+ * @brief Notify task from an ISR. If the notified task should preempt the current task,
+ * context switch is performed once all pending ISRs have been serviced.
+ *
+ * @param pTask Pointer to taskHandle struct of the notified task
+ * @param value Bits to set for TASK_NOTIFY_SET_BITS or new value for TASK_NOTIFY_OVERWRITE. Ignored for TASK_NOTIFY_INCREMENT.
+ * @param action Action performed on the notification value
+ * @retval RET_SUCCESS if task is notified
+ */
+int taskNotifyFromISR(taskHandleType *pTask, uint32_t value, taskNotifyActionType action)
+{
+    assert(pTask != NULL);
+
+    bool contextSwitchRequired;
+
+    uint32_t savedState = ENTER_CRITICAL_SECTION_FROM_ISR();
+
+    contextSwitchRequired = taskNotifyUnsafe(pTask, value, action);
+
+    EXIT_CRITICAL_SECTION_FROM_ISR(savedState);
+
+    if (contextSwitchRequired)
+    {
+        taskYieldFromISR();
+    }
+
+    return RET_SUCCESS;
+}
+
+/**
+ * @brief Wait for a notification of the current task. This function cannot be called from an ISR.
+ *
+ * @param clearBitsOnExit Bits of the notification value to clear once the notification is received
+ * @param pValue Pointer to the variable to be assigned the notification value before the bits are cleared. Can be NULL.
+ * @param waitTicks Number of ticks to wait if no notification is pending
+ * @retval RET_SUCCESS if notification is received
+ * @retval RET_EMPTY if no notification is pending
+ * @retval RET_TIMEOUT if timeout occured while waiting for notification
+ */
+int taskNotifyWait(uint32_t clearBitsOnExit, uint32_t *pValue, uint32_t waitTicks)
+{
+    taskHandleType *currentTask = taskPool.currentTask;
+
+    int retCode;
+
+    ENTER_CRITICAL_SECTION();
+
+retry:
+    if (currentTask->notifyPending)
+    {
+        if (pValue != NULL)
+        {
+            *pValue = currentTask->notifyValue;
+        }
+
+        currentTask->notifyValue &= ~clearBitsOnExit;
+        currentTask->notifyPending = false;
+
+        retCode = RET_SUCCESS;
+    }
+    else if (waitTicks == TASK_NO_WAIT)
+    {
+        retCode = RET_EMPTY;
+    }
+    else
+    {
+        /* Block current task and give CPU to other tasks while waiting for notification*/
+        taskBlock(currentTask, WAIT_FOR_NOTIFICATION, waitTicks);
+
+        if (currentTask->wakeupReason == WAIT_TIMEOUT)
+        {
+            retCode = RET_TIMEOUT;
+        }
+        /*Notification received, or task was suspended while waiting and later resumed. In both cases, check
+          for pending notification again*/
+        else
+        {
+            goto retry;
+        }
+    }
+
+    EXIT_CRITICAL_SECTION();
+
+    return retCode;
+}
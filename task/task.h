@@ -28,17 +28,19 @@
 #include <assert.h>
 #include "osConfig.h"
 #include "taskQueue/taskQueue.h"
+#include "readyQueue/readyQueue.h"
+#include "hrTimer/hrTimer.h"
 
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
-#define TASK_LOWEST_PRIORITY 0xff
+#define TASK_LOWEST_PRIORITY (TASK_PRIORITY_LEVELS - 1)
 #define TASK_HIGHEST_PRIORITY 0
 
 #define TASK_NO_WAIT 0
-#define TASK_MAX_WAIT 0xffffffffUL
+#define TASK_MAX_WAIT 0xffffffffUL // Wait indefinitely. Such waits never time out and are not tracked on every tick.
 
     extern void taskExitFunction();
 
@@ -75,9 +77,11 @@ extern "C"
  * @param stackSize Size of task stack in bytes.
  * @param taskEntryFunction Task  entry  function.
  * @param taskParams Entry point parameter.
- * @param taskPriority Task priority.
+ * @param taskPriority Task priority. Must be less than TASK_PRIORITY_LEVELS; otherwise, compilation fails.
  */
 #define TASK_DEFINE(name, stackSize, taskEntryFunction, taskParams, taskPriority)    \
+    typedef char name##PriorityOutOfRange                                            \
+        [((taskPriority) < TASK_PRIORITY_LEVELS) ? 1 : -1];                          \
     void taskEntryFunction(void *);                                                  \
     uint32_t name##Stack[stackSize / sizeof(uint32_t)] = {                           \
         [stackSize / sizeof(uint32_t) - 1] = 0x01000000,                             \
@@ -93,7 +97,14 @@ extern "C"
         .remainingSleepTicks = 0,                                                    \
         .status = TASK_STATUS_READY,                                                 \
         .blockedReason = BLOCK_REASON_NONE,                                          \
-        .wakeupReason = WAKEUP_REASON_NONE}
+        .wakeupReason = WAKEUP_REASON_NONE,                                          \
+        .timeSliceTicks = TASK_TIME_SLICE_TICKS,                                     \
+        .remainingTimeSliceTicks = TASK_TIME_SLICE_TICKS,                            \
+        .notifyValue = 0,                                                            \
+        .notifyPending = false,                                                      \
+        .pWaitData = NULL,                                                           \
+        .schedNode = {.pTask = &name, .nextTaskNode = NULL, .prevTaskNode = NULL},   \
+        .waitNode = {.pTask = &name, .nextTaskNode = NULL, .prevTaskNode = NULL}}
 
     typedef void (*taskFunctionType)(void *params);
 
@@ -115,6 +126,9 @@ extern "C"
         WAIT_FOR_MSG_QUEUE_SPACE,
         WAIT_FOR_COND_VAR,
         WAIT_FOR_TIMER_TIMEOUT,
+        WAIT_FOR_NOTIFICATION,
+        WAIT_FOR_EVENT_GROUP,
+        WAIT_FOR_SPSC_RING_ITEM,
 
     } blockedReasonType;
 
@@ -127,29 +141,48 @@ extern "C"
         MUTEX_LOCKED,
         MSG_QUEUE_DATA_AVAILABLE,
         MSG_QUEUE_SPACE_AVAILABE,
+        MSG_QUEUE_DATA_RECEIVED,
         COND_VAR_SIGNALLED,
         TIMER_TIMEOUT,
-        RESUME
+        RESUME,
+        NOTIFICATION_RECEIVED,
+        EVENT_GROUP_FLAGS_SET,
+        SPSC_RING_ITEM_PUSHED
 
     } wakeupReasonType;
 
+    /*Action performed on the notification value of the notified task*/
+    typedef enum
+    {
+        TASK_NOTIFY_SET_BITS,  // Set the bits of the notification value
+        TASK_NOTIFY_INCREMENT, // Increment the notification value by one
+        TASK_NOTIFY_OVERWRITE  // Overwrite the notification value
+    } taskNotifyActionType;
+
     /*Task control block struct*/
     typedef struct taskHandle
     {
         uint32_t stackPointer;
         taskFunctionType taskEntry;
         void *params;
-        uint32_t remainingSleepTicks;
+        uint32_t remainingSleepTicks; // Ticks until timeout, relative to the previous task in the blockedQueue
         taskStatusType status;
         blockedReasonType blockedReason;
         wakeupReasonType wakeupReason;
+        uint32_t timeSliceTicks;          // Number of ticks the task runs before tasks of equal priority get CPU. 0 if not time sliced
+        uint32_t remainingTimeSliceTicks; // Number of ticks left in the current time slice
+        uint32_t notifyValue;             // Notification value updated by taskNotify
+        bool notifyPending;               // Set if the task has been notified since it last received a notification
+        void *pWaitData;                  // Wait specific data of the kernel object the task is waiting on
         uint8_t priority;
+        taskNodeType schedNode; // Links the task into the readyQueue or the blockedQueue
+        taskNodeType waitNode;  // Links the task into the wait queue of a kernel object
 
     } taskHandleType;
 
     typedef struct
     {
-        taskQueueType readyQueue;
+        readyQueueType readyQueue;
         taskQueueType blockedQueue;
         taskHandleType *currentTask;
 
@@ -170,11 +203,28 @@ extern "C"
     {
         assert(pTask != NULL);
 
-        taskQueueAdd(&taskPool.readyQueue, pTask);
+        readyQueueAdd(&taskPool.readyQueue, pTask);
     }
 
     extern void taskBlock(taskHandleType *pTask, blockedReasonType blockedReason, uint32_t ticks);
 
+    /**
+     * @brief Check if the woken up task should preempt the current task. Unless TASK_PREEMPT_ON_EQUAL_PRIORITY is set,
+     * task of equal priority waits until the current task blocks, yields or its time slice expires.
+     *
+     * @param pTask Pointer to taskHandle struct of the woken up task
+     * @retval true if context switch is required
+     * @retval false otherwise
+     */
+    static inline bool taskPreemptionRequired(taskHandleType *pTask)
+    {
+#if TASK_PREEMPT_ON_EQUAL_PRIORITY
+        return pTask->priority <= taskPool.currentTask->priority;
+#else
+        return pTask->priority < taskPool.currentTask->priority;
+#endif
+    }
+
     /**
      * @brief Block task for specified number of RTOS Ticks
      *
@@ -196,12 +246,22 @@ extern "C"
     }
 
     /**
-     * @brief Block task for specified number of microseconds
+     * @brief Block task for specified number of microseconds. If OS_HR_TIMER is set, sleeps shorter than a tick
+     * use the high resolution counter. Sleeps of a tick or more, and all sleeps without OS_HR_TIMER, are rounded
+     * down to whole ticks. Only this function uses the high resolution counter; timeouts of the other kernel waits
+     * are always counted in ticks.
      *
      * @param sleepTimeUS
      */
     static inline void taskSleepUS(uint32_t sleepTimeUS)
     {
+#if OS_HR_TIMER
+        if (sleepTimeUS < OS_TICK_INTERVAL_US)
+        {
+            hrTimerSleepUS(sleepTimeUS);
+            return;
+        }
+#endif
         taskSleep(US_TO_OS_TICKS(sleepTimeUS));
     }
 
@@ -209,10 +269,24 @@ extern "C"
 
     void taskBlock(taskHandleType *pTask, blockedReasonType blockedReason, uint32_t ticks);
 
+    void taskSleepUntil(uint32_t *pLastWakeTick, uint32_t periodTicks);
+
     void taskSuspend(taskHandleType *pTask);
 
     int taskResume(taskHandleType *pTask);
 
+    int taskResumeFromISR(taskHandleType *pTask);
+
+    void taskSetPriority(taskHandleType *pTask, uint8_t priority);
+
+    void taskSetTimeSlice(taskHandleType *pTask, uint32_t timeSliceTicks);
+
+    int taskNotify(taskHandleType *pTask, uint32_t value, taskNotifyActionType action);
+
+    int taskNotifyFromISR(taskHandleType *pTask, uint32_t value, taskNotifyActionType action);
+
+    int taskNotifyWait(uint32_t clearBitsOnExit, uint32_t *pValue, uint32_t waitTicks);
+
 #ifdef __cplusplus
 }
 #endif
@@ -23,82 +23,114 @@
  */
 
 #include <stdint.h>
-#include <stdlib.h>
 #include <assert.h>
 #include "retCodes.h"
 #include "osConfig.h"
 #include "task/task.h"
 #include "taskQueue.h"
+
 /**
- * @brief Dynamically allocate memory for new task Node.
+ * @brief Add task node to front of the Queue without sorting
  *
- * @param pTask Pointer to taskHandle struct
- * @return Pointer to new task node
+ * @param pTaskQueue Pointer to the taskQueue struct.
+ * @param pTaskNode  Pointer to the taskNode struct embedded in the taskHandle struct
  */
-static inline taskNodeType *newNode(taskHandleType *pTask)
+void taskQueueAddToFront(taskQueueType *pTaskQueue, taskNodeType *pTaskNode)
 {
-    taskNodeType *newTaskNode = (taskNodeType *)malloc(sizeof(taskNodeType));
+    assert(pTaskQueue != NULL);
+    assert(pTaskNode != NULL);
 
-    assert(newTaskNode != NULL);
+    pTaskNode->prevTaskNode = NULL;
+    pTaskNode->nextTaskNode = pTaskQueue->head;
 
-    newTaskNode->pTask = pTask;
-    newTaskNode->nextTaskNode = NULL;
-    return newTaskNode;
+    if (taskQueueEmpty(pTaskQueue))
+    {
+        pTaskQueue->tail = pTaskNode;
+    }
+    else
+    {
+        pTaskQueue->head->prevTaskNode = pTaskNode;
+    }
+
+    pTaskQueue->head = pTaskNode;
 }
 
 /**
- * @brief Add task to front of the Queue without sorting
+ * @brief Add task node to back of the Queue without sorting
  *
  * @param pTaskQueue Pointer to the taskQueue struct.
- * @param pTask  Pointer to the taskHandle struct
+ * @param pTaskNode  Pointer to the taskNode struct embedded in the taskHandle struct
  */
-void taskQueueAddToFront(taskQueueType *pTaskQueue, taskHandleType *pTask)
+void taskQueueAddToBack(taskQueueType *pTaskQueue, taskNodeType *pTaskNode)
 {
     assert(pTaskQueue != NULL);
-    assert(pTask != NULL);
+    assert(pTaskNode != NULL);
 
-    taskNodeType *newTaskNode = newNode(pTask);
+    pTaskNode->prevTaskNode = pTaskQueue->tail;
+    pTaskNode->nextTaskNode = NULL;
 
-    newTaskNode->nextTaskNode = pTaskQueue->head;
+    if (taskQueueEmpty(pTaskQueue))
+    {
+        pTaskQueue->head = pTaskNode;
+    }
+    else
+    {
+        pTaskQueue->tail->nextTaskNode = pTaskNode;
+    }
 
-    pTaskQueue->head = newTaskNode;
+    pTaskQueue->tail = pTaskNode;
 }
 
 /**
- * @brief Add task to Queue and  sort tasks in ascending order of
- * their priority
- * @param pTaskQueue
- * @param pTask
+ * @brief Insert task node before the specified node of the Queue
+ *
+ * @param pTaskQueue Pointer to the taskQueue struct.
+ * @param pPosNode Pointer to the node before which the task node is inserted. If NULL, task node is added to back of the Queue.
+ * @param pTaskNode  Pointer to the taskNode struct embedded in the taskHandle struct
  */
-void taskQueueAdd(taskQueueType *pTaskQueue, taskHandleType *pTask)
+void taskQueueInsertBefore(taskQueueType *pTaskQueue, taskNodeType *pPosNode, taskNodeType *pTaskNode)
 {
     assert(pTaskQueue != NULL);
-    assert(pTask != NULL);
+    assert(pTaskNode != NULL);
 
-    taskNodeType *newTaskNode = newNode(pTask);
-
-    if (taskQueueEmpty(pTaskQueue))
+    if (pPosNode == NULL)
     {
-        pTaskQueue->head = newTaskNode;
+        taskQueueAddToBack(pTaskQueue, pTaskNode);
     }
-    else if (pTaskQueue->head->pTask->priority > pTask->priority)
+    else if (pPosNode == pTaskQueue->head)
     {
-        newTaskNode->nextTaskNode = pTaskQueue->head;
-
-        pTaskQueue->head = newTaskNode;
+        taskQueueAddToFront(pTaskQueue, pTaskNode);
     }
     else
     {
-        taskNodeType *currentTaskNode = pTaskQueue->head;
-        while (currentTaskNode->nextTaskNode && currentTaskNode->nextTaskNode->pTask->priority <= pTask->priority)
-        {
-            currentTaskNode = currentTaskNode->nextTaskNode;
-        }
+        pTaskNode->prevTaskNode = pPosNode->prevTaskNode;
+        pTaskNode->nextTaskNode = pPosNode;
+
+        pPosNode->prevTaskNode->nextTaskNode = pTaskNode;
+        pPosNode->prevTaskNode = pTaskNode;
+    }
+}
 
-        newTaskNode->nextTaskNode = currentTaskNode->nextTaskNode;
+/**
+ * @brief Add task node to Queue and  sort tasks in ascending order of
+ * their priority
+ * @param pTaskQueue Pointer to the taskQueue struct.
+ * @param pTaskNode  Pointer to the taskNode struct embedded in the taskHandle struct
+ */
+void taskQueueAdd(taskQueueType *pTaskQueue, taskNodeType *pTaskNode)
+{
+    assert(pTaskQueue != NULL);
+    assert(pTaskNode != NULL);
 
-        currentTaskNode->nextTaskNode = newTaskNode;
+    taskNodeType *currentTaskNode = pTaskQueue->head;
+
+    /*Tasks with equal priority are served in FIFO order; hence, skip all the tasks with equal or higher priority*/
+    while (currentTaskNode && currentTaskNode->pTask->priority <= pTaskNode->pTask->priority)
+    {
+        currentTaskNode = currentTaskNode->nextTaskNode;
     }
+
+    taskQueueInsertBefore(pTaskQueue, currentTaskNode, pTaskNode);
 }
 
 /**
@@ -114,61 +146,98 @@ taskHandleType *taskQueueGet(taskQueueType *ptaskQueue)
 
     if (!taskQueueEmpty(ptaskQueue))
     {
-        taskHandleType *pTask = ptaskQueue->head->pTask;
-
-        taskNodeType *temp = ptaskQueue->head->nextTaskNode;
+        taskNodeType *pTaskNode = ptaskQueue->head;
 
-        free(ptaskQueue->head);
+        taskQueueRemove(ptaskQueue, pTaskNode);
 
-        ptaskQueue->head = temp;
-
-        return pTask;
+        return pTaskNode->pTask;
     }
 
     return NULL;
 }
 
 /**
- * @brief Remove head node from Queue
+ * @brief Remove task node from Queue
  *
- * @param pTaskQueue
+ * @param pTaskQueue Pointer to taskQueue struct
+ * @param pTaskNode Pointer to the taskNode struct embedded in the taskHandle struct
  */
-static inline void taskQueueRemoveHead(taskQueueType *pTaskQueue)
+void taskQueueRemove(taskQueueType *pTaskQueue, taskNodeType *pTaskNode)
 {
-    taskNodeType *temp = pTaskQueue->head->nextTaskNode;
+    assert(pTaskQueue != NULL);
+    assert(pTaskNode != NULL);
+
+    if (pTaskNode->prevTaskNode != NULL)
+    {
+        pTaskNode->prevTaskNode->nextTaskNode = pTaskNode->nextTaskNode;
+    }
+    else
+    {
+        pTaskQueue->head = pTaskNode->nextTaskNode;
+    }
 
-    free(pTaskQueue->head);
+    if (pTaskNode->nextTaskNode != NULL)
+    {
+        pTaskNode->nextTaskNode->prevTaskNode = pTaskNode->prevTaskNode;
+    }
+    else
+    {
+        pTaskQueue->tail = pTaskNode->prevTaskNode;
+    }
 
-    pTaskQueue->head = temp;
+    pTaskNode->prevTaskNode = NULL;
+    pTaskNode->nextTaskNode = NULL;
 }
 
 /**
- * @brief Remove task from Queue
+ * @brief Add task node to a Queue sorted by timeout. The remainingSleepTicks of each task in the Queue is stored as
+ * delta relative to the task before it; hence, only the front task's remainingSleepTicks needs to be decremented on every tick.
  *
- * @param pTaskQueue
- * @param pTask
+ * @param pTaskQueue Pointer to the taskQueue struct.
+ * @param pTaskNode Pointer to the taskNode struct embedded in the taskHandle struct
+ * @param ticks Number of ticks until timeout of the task
  */
-void taskQueueRemove(taskQueueType *pTaskQueue, taskHandleType *pTask)
+void taskQueueAddDelta(taskQueueType *pTaskQueue, taskNodeType *pTaskNode, uint32_t ticks)
 {
     assert(pTaskQueue != NULL);
-    assert(pTask != NULL);
+    assert(pTaskNode != NULL);
+
+    taskNodeType *currentTaskNode = pTaskQueue->head;
 
-    if (pTask == pTaskQueue->head->pTask)
+    /*Tasks timing out at the same tick are served in FIFO order; hence, skip all the tasks timing out at or before the given tick*/
+    while (currentTaskNode && currentTaskNode->pTask->remainingSleepTicks <= ticks)
     {
-        taskQueueRemoveHead(pTaskQueue);
+        ticks -= currentTaskNode->pTask->remainingSleepTicks;
+        currentTaskNode = currentTaskNode->nextTaskNode;
     }
 
-    else
-    {
-        taskNodeType *currentTaskNode = pTaskQueue->head;
+    pTaskNode->pTask->remainingSleepTicks = ticks;
 
-        while (currentTaskNode->nextTaskNode->pTask != pTask)
-            currentTaskNode = currentTaskNode->nextTaskNode;
+    /*Following task now times out relative to the inserted task*/
+    if (currentTaskNode != NULL)
+    {
+        currentTaskNode->pTask->remainingSleepTicks -= ticks;
+    }
 
-        taskNodeType *temp = currentTaskNode->nextTaskNode->nextTaskNode;
+    taskQueueInsertBefore(pTaskQueue, currentTaskNode, pTaskNode);
+}
 
-        free(currentTaskNode->nextTaskNode);
+/**
+ * @brief Remove task node from a Queue sorted by timeout.
+ *
+ * @param pTaskQueue Pointer to taskQueue struct
+ * @param pTaskNode Pointer to the taskNode struct embedded in the taskHandle struct
+ */
+void taskQueueRemoveDelta(taskQueueType *pTaskQueue, taskNodeType *pTaskNode)
+{
+    assert(pTaskQueue != NULL);
+    assert(pTaskNode != NULL);
 
-        currentTaskNode->nextTaskNode = temp;
+    /*Hand over the delta ticks of the removed task to the following task*/
+    if (pTaskNode->nextTaskNode != NULL)
+    {
+        pTaskNode->nextTaskNode->pTask->remainingSleepTicks += pTaskNode->pTask->remainingSleepTicks;
     }
-}
\ No newline at end of file
+
+    taskQueueRemove(pTaskQueue, pTaskNode);
+}
@@ -34,24 +34,36 @@ extern "C"
     /*Forward declaration of taskHandleType*/
     typedef struct taskHandle taskHandleType;
 
+    /*Doubly linked queue node embedded in the taskHandle struct. Queue operations only link and unlink these nodes;
+      hence, no memory is allocated or freed while adding or removing tasks, and a known task is removed in constant time.*/
     typedef struct taskNode
     {
         taskHandleType *pTask;
         struct taskNode *nextTaskNode;
+        struct taskNode *prevTaskNode;
     } taskNodeType;
 
     typedef struct
     {
         taskNodeType *head;
+        taskNodeType *tail;
     } taskQueueType;
 
     taskHandleType *taskQueueGet(taskQueueType *pTaskQueue);
 
-    void taskQueueAdd(taskQueueType *pTaskQueue, taskHandleType *pTask);
+    void taskQueueAdd(taskQueueType *pTaskQueue, taskNodeType *pTaskNode);
 
-    void taskQueueAddToFront(taskQueueType *pTaskQueue, taskHandleType *pTask);
+    void taskQueueAddToFront(taskQueueType *pTaskQueue, taskNodeType *pTaskNode);
 
-    void taskQueueRemove(taskQueueType *pTaskQueue, taskHandleType *pTask);
+    void taskQueueAddToBack(taskQueueType *pTaskQueue, taskNodeType *pTaskNode);
+
+    void taskQueueInsertBefore(taskQueueType *pTaskQueue, taskNodeType *pPosNode, taskNodeType *pTaskNode);
+
+    void taskQueueRemove(taskQueueType *pTaskQueue, taskNodeType *pTaskNode);
+
+    void taskQueueAddDelta(taskQueueType *pTaskQueue, taskNodeType *pTaskNode, uint32_t ticks);
+
+    void taskQueueRemoveDelta(taskQueueType *pTaskQueue, taskNodeType *pTaskNode);
 
     /**
      * @brief Check if taskQueue is empty
@@ -65,6 +77,20 @@ extern "C"
         return pTaskQueue->head == NULL;
     }
 
+    /**
+     * @brief Check if task node is linked in the task queue. A task node can be linked in only one
+     * queue at a time; hence, the check is performed in constant time.
+     *
+     * @param pTaskQueue Pointer to the taskQueue struct
+     * @param pTaskNode Pointer to the taskNode struct
+     * @retval true if task node is linked in the taskQueue
+     * @retval false, otherwise
+     */
+    static inline bool taskQueueNodeLinked(taskQueueType *pTaskQueue, taskNodeType *pTaskNode)
+    {
+        return pTaskNode->prevTaskNode != NULL || pTaskQueue->head == pTaskNode;
+    }
+
     /**
      * @brief Get task corresponding to front node from the task queue without removing the node
      *
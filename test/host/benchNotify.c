@@ -0,0 +1,166 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Round trip cost of direct-to-task notifications compared with a pair of semaphores. A client task signals a lower
+ * priority server task, which runs once the client blocks on the response and signals back; each round trip takes two
+ * context switches. Time is measured on the host, where a context switch costs far more than on the target; hence, the
+ * cost of a bare host context switch round trip is measured as well and subtracted to estimate the kernel part. The
+ * kernel part is a small difference of two large host timings; results depend on the host and vary from run to run by
+ * more than the difference between the two primitives, so only repeated runs on the same host are comparable.
+ */
+
+#include "hostTest.h"
+#include "hostKernel.c"
+#include "semaphore/semaphore.c"
+
+#define BENCH_CLIENT_PRIORITY 4
+
+#define BENCH_SERVER_PRIORITY 5
+
+#define BENCH_ROUND_TRIPS 200000
+
+SEMAPHORE_DEFINE(requestSem, 0, 1);
+
+SEMAPHORE_DEFINE(responseSem, 0, 1);
+
+TASK_DEFINE(clientTask, 1024, clientTaskHandler, NULL, BENCH_CLIENT_PRIORITY);
+
+TASK_DEFINE(notifyServerTask, 1024, notifyServerTaskHandler, NULL, BENCH_SERVER_PRIORITY);
+
+TASK_DEFINE(semaphoreServerTask, 1024, semaphoreServerTaskHandler, NULL, BENCH_SERVER_PRIORITY);
+
+static ucontext_t benchMainContext;
+
+static ucontext_t benchSwitchContext;
+
+/*Cost of a round trip of bare host context switches in nanoseconds*/
+static double benchSwitchRoundTrip;
+
+static void benchSwitchHandler()
+{
+    while (1)
+    {
+        swapcontext(&benchSwitchContext, &benchMainContext);
+    }
+}
+
+/**
+ * @brief Measure the average cost of switching to another host context and back.
+ */
+static double benchSwitch()
+{
+    static char stack[HOST_TASK_STACK_SIZE];
+
+    getcontext(&benchSwitchContext);
+    benchSwitchContext.uc_stack.ss_sp = stack;
+    benchSwitchContext.uc_stack.ss_size = sizeof(stack);
+    makecontext(&benchSwitchContext, benchSwitchHandler, 0);
+
+    uint64_t start = hostTestNanoseconds();
+
+    for (uint32_t i = 0; i < BENCH_ROUND_TRIPS; i++)
+    {
+        swapcontext(&benchMainContext, &benchSwitchContext);
+    }
+
+    return (double)(hostTestNanoseconds() - start) / BENCH_ROUND_TRIPS;
+}
+
+static void benchReport(const char *name, double roundTrip)
+{
+    printf("%10s %16.1f %16.1f\n", name, roundTrip, roundTrip - benchSwitchRoundTrip);
+}
+
+void clientTaskHandler(void *params)
+{
+    (void)params;
+
+    uint64_t start = hostTestNanoseconds();
+
+    for (uint32_t i = 0; i < BENCH_ROUND_TRIPS; i++)
+    {
+        taskNotify(&notifyServerTask, 0, TASK_NOTIFY_INCREMENT);
+
+        taskNotifyWait(0, NULL, TASK_MAX_WAIT);
+    }
+
+    benchReport("notify", (double)(hostTestNanoseconds() - start) / BENCH_ROUND_TRIPS);
+
+    start = hostTestNanoseconds();
+
+    for (uint32_t i = 0; i < BENCH_ROUND_TRIPS; i++)
+    {
+        semaphoreGive(&requestSem);
+
+        semaphoreTake(&responseSem, TASK_MAX_WAIT);
+    }
+
+    benchReport("semaphore", (double)(hostTestNanoseconds() - start) / BENCH_ROUND_TRIPS);
+
+    exit(0);
+}
+
+void notifyServerTaskHandler(void *params)
+{
+    (void)params;
+
+    while (1)
+    {
+        taskNotifyWait(0, NULL, TASK_MAX_WAIT);
+
+        taskNotify(&clientTask, 0, TASK_NOTIFY_INCREMENT);
+    }
+}
+
+void semaphoreServerTaskHandler(void *params)
+{
+    (void)params;
+
+    while (1)
+    {
+        semaphoreTake(&requestSem, TASK_MAX_WAIT);
+
+        semaphoreGive(&responseSem);
+    }
+}
+
+int main()
+{
+    benchSwitchRoundTrip = benchSwitch();
+
+    printf("%10s %16s %16s\n", "", "ns/round trip", "kernel ns");
+
+    benchReport("switch", benchSwitchRoundTrip);
+
+    taskStart(&clientTask);
+
+    taskStart(&notifyServerTask);
+
+    taskStart(&semaphoreServerTask);
+
+    hostSchedulerStart();
+
+    return 0;
+}
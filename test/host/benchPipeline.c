@@ -0,0 +1,106 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Context switches per second of a two-stage pipeline, whose producer and consumer tasks have equal priority and
+ * are connected by a message queue. Build with HOST_TASK_PREEMPT_ON_EQUAL_PRIORITY set to 0 and 1 to compare the
+ * preemption policies; see Makefile. Tasks spend simulated CPU cycles per item and time slices expire on simulated
+ * ticks; hence, the results only depend on the kernel and are the same on every run.
+ */
+
+#include "hostTest.h"
+#include "hostKernel.c"
+#include "messageQueue/messageQueue.c"
+
+#define BENCH_TASK_PRIORITY 5
+
+#define BENCH_QUEUE_LENGTH 8
+
+#define BENCH_PRODUCE_CYCLES 2000
+
+#define BENCH_CONSUME_CYCLES 2000
+
+#define BENCH_TICKS 1000
+
+MSG_QUEUE_DEFINE(benchQueue, BENCH_QUEUE_LENGTH, sizeof(uint32_t));
+
+TASK_DEFINE(producerTask, 1024, producerTaskHandler, NULL, BENCH_TASK_PRIORITY);
+
+TASK_DEFINE(consumerTask, 1024, consumerTaskHandler, NULL, BENCH_TASK_PRIORITY);
+
+static uint32_t benchConsumed = 0;
+
+void producerTaskHandler(void *params)
+{
+    (void)params;
+
+    uint32_t item = 0;
+
+    while (1)
+    {
+        hostTaskRun(BENCH_PRODUCE_CYCLES);
+
+        msgQueueSend(&benchQueue, &item, TASK_MAX_WAIT);
+
+        item++;
+
+        if (osTicksGet() >= BENCH_TICKS)
+        {
+            double seconds = (double)OS_TICKS_TO_US(osTicksGet()) / 1000000;
+
+            printf("TASK_PREEMPT_ON_EQUAL_PRIORITY %d: %.0f switches/s, %.0f items/s, %.2f switches/item\n",
+                   TASK_PREEMPT_ON_EQUAL_PRIORITY, hostContextSwitches / seconds, benchConsumed / seconds,
+                   (double)hostContextSwitches / benchConsumed);
+
+            exit(0);
+        }
+    }
+}
+
+void consumerTaskHandler(void *params)
+{
+    (void)params;
+
+    uint32_t item;
+
+    while (1)
+    {
+        msgQueueReceive(&benchQueue, &item, TASK_MAX_WAIT);
+
+        hostTaskRun(BENCH_CONSUME_CYCLES);
+
+        benchConsumed++;
+    }
+}
+
+int main()
+{
+    taskStart(&producerTask);
+
+    taskStart(&consumerTask);
+
+    hostSchedulerStart();
+
+    return 0;
+}
@@ -0,0 +1,139 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Tick interrupt cost with 10, 100 and 1000 running periodic timers. The SysTick handler, which advances the timing
+ * wheel, is compared with a walk over all the running timers as done by the reference timer model. Time is measured
+ * on the host; hence, only the growth with the number of timers is meaningful, not the absolute values.
+ */
+
+#include <stdlib.h>
+#include "hostTest.h"
+#include "hostKernel.c"
+#include "timerModel.h"
+
+#define BENCH_MAX_TIMERS 1000
+
+#define BENCH_TICKS 200000
+
+static timerNodeType benchTimers[BENCH_MAX_TIMERS];
+
+static timerModelType benchModels[BENCH_MAX_TIMERS];
+
+void benchTimerHandler(timerNodeType *pTimerNode, void *arg, uint32_t overruns)
+{
+    (void)pTimerNode;
+    (void)arg;
+    (void)overruns;
+}
+
+/**
+ * @brief Start the given number of periodic timers with random intervals, on the wheel and on the model alike.
+ * Expired timers are not drained; further expiries are counted as overruns, which costs the same as queueing them.
+ */
+static void benchTimersStart(uint32_t timerCount)
+{
+    for (uint32_t i = 0; i < timerCount; i++)
+    {
+        uint32_t intervalTicks = 10 + rand() % 5000;
+
+        timerModelNodeInit(&benchTimers[i], benchTimerHandler, TIMER_MODE_PERIODIC, NULL);
+
+        timerStart(&benchTimers[i], intervalTicks);
+
+        timerModelStart(&benchModels[i], intervalTicks, true);
+    }
+}
+
+static void benchTimersStop(uint32_t timerCount)
+{
+    for (uint32_t i = 0; i < timerCount; i++)
+    {
+        timerStop(&benchTimers[i]);
+    }
+
+    while (timerPendingQueuePop(&timerPendingQueue) != NULL)
+        ;
+}
+
+/**
+ * @brief Measure the average cost of the SysTick handler per tick.
+ */
+static double benchWheelTick()
+{
+    uint64_t start = hostTestNanoseconds();
+
+    for (uint32_t tick = 0; tick < BENCH_TICKS; tick++)
+    {
+        SYSTICK_HANDLER();
+    }
+
+    return (double)(hostTestNanoseconds() - start) / BENCH_TICKS;
+}
+
+/**
+ * @brief Measure the average cost of walking all the running timers of the model per tick.
+ */
+static double benchLinearTick(uint32_t timerCount)
+{
+    volatile uint32_t expiries = 0;
+
+    uint64_t start = hostTestNanoseconds();
+
+    for (uint32_t tick = 0; tick < BENCH_TICKS; tick++)
+    {
+        for (uint32_t i = 0; i < timerCount; i++)
+        {
+            expiries += timerModelTick(&benchModels[i]);
+        }
+    }
+
+    return (double)(hostTestNanoseconds() - start) / BENCH_TICKS;
+}
+
+int main()
+{
+    const uint32_t timerCounts[] = {10, 100, 1000};
+
+    hostKernelInit();
+
+    srand(1);
+
+    printf("%8s %18s %18s\n", "timers", "wheel ns/tick", "linear ns/tick");
+
+    for (uint32_t i = 0; i < sizeof(timerCounts) / sizeof(timerCounts[0]); i++)
+    {
+        benchTimersStart(timerCounts[i]);
+
+        double wheelTick = benchWheelTick();
+
+        double linearTick = benchLinearTick(timerCounts[i]);
+
+        benchTimersStop(timerCounts[i]);
+
+        printf("%8u %18.1f %18.1f\n", timerCounts[i], wheelTick, linearTick);
+    }
+
+    return 0;
+}
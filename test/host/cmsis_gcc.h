@@ -0,0 +1,115 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Host stand-in for the CMSIS core header. Core registers are plain structs and intrinsics that wait for interrupts
+ * do nothing; hence, kernel sources can be compiled and exercised on a host. PRIMASK is kept in hostPrimask and
+ * unmasking interrupts takes the pending ones, as the core does; see hostKernel.c.
+ */
+
+#ifndef __SANO_RTOS_HOST_CMSIS_GCC_H
+#define __SANO_RTOS_HOST_CMSIS_GCC_H
+
+#include <stdint.h>
+
+#define __NVIC_PRIO_BITS 4
+
+#define EXC_RETURN_THREAD_PSP 0xFFFFFFFDUL
+
+typedef enum
+{
+    PendSV_IRQn = -2,
+    SysTick_IRQn = -1
+} IRQn_Type;
+
+typedef struct
+{
+    volatile uint32_t ICSR;
+    volatile uint32_t SCR;
+} SCB_Type;
+
+typedef struct
+{
+    volatile uint32_t CTRL;
+    volatile uint32_t LOAD;
+    volatile uint32_t VAL;
+    volatile uint32_t CALIB;
+} SysTick_Type;
+
+extern SCB_Type hostSCB;
+extern SysTick_Type hostSysTick;
+extern uint32_t SystemCoreClock;
+extern uint32_t hostPrimask;
+extern uint32_t hostPSP;
+
+void hostInterruptsTake(void);
+
+#define SCB (&hostSCB)
+#define SysTick (&hostSysTick)
+
+#define SCB_ICSR_PENDSVSET_Msk (1UL << 28)
+#define SCB_ICSR_PENDSTSET_Msk (1UL << 26)
+#define SCB_ICSR_PENDSTCLR_Msk (1UL << 25)
+#define SysTick_CTRL_ENABLE_Msk (1UL << 0)
+#define SysTick_CTRL_TICKINT_Msk (1UL << 1)
+#define SysTick_CTRL_CLKSOURCE_Msk (1UL << 2)
+#define SysTick_CTRL_COUNTFLAG_Msk (1UL << 16)
+#define SysTick_LOAD_RELOAD_Msk 0xFFFFFFUL
+
+static inline void __disable_irq(void) { hostPrimask = 1; }
+static inline uint32_t __get_PRIMASK(void) { return hostPrimask; }
+
+static inline void __enable_irq(void)
+{
+    hostPrimask = 0;
+    hostInterruptsTake();
+}
+
+static inline void __set_PRIMASK(uint32_t priMask)
+{
+    if (priMask == 0)
+    {
+        __enable_irq();
+    }
+    else
+    {
+        __disable_irq();
+    }
+}
+
+static inline uint32_t __get_BASEPRI(void) { return 0; }
+static inline void __set_BASEPRI(uint32_t basePri) { (void)basePri; }
+static inline void __set_BASEPRI_MAX(uint32_t basePri) { (void)basePri; }
+static inline uint32_t __get_PSP(void) { return hostPSP; }
+static inline void __set_PSP(uint32_t topOfProcStack) { (void)topOfProcStack; }
+static inline void __set_CONTROL(uint32_t control) { (void)control; }
+static inline void __ISB(void) { __sync_synchronize(); }
+static inline void __DSB(void) { __sync_synchronize(); }
+static inline void __DMB(void) { __sync_synchronize(); }
+static inline void __WFI(void) {}
+static inline uint8_t __CLZ(uint32_t value) { return (value == 0) ? 32 : (uint8_t)__builtin_clz(value); }
+static inline uint32_t SysTick_Config(uint32_t ticks) { (void)ticks; return 0; }
+static inline void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority) { (void)IRQn; (void)priority; }
+
+#endif
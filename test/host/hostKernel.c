@@ -0,0 +1,235 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Host build of the kernel. Each test includes this file to get the kernel sources along with their static
+ * functions. Until hostSchedulerStart is called, no context switch is performed; the test plays the role of the
+ * running task and calls the interrupt handlers itself. Once the scheduler is started, each task runs on its own
+ * host context and PendSV is emulated by switching the contexts whenever interrupts are unmasked in thread mode.
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include <ucontext.h>
+#include "task/task.h"
+
+/*Initial stack frame of TASK_DEFINE holds 32-bit code addresses, which cannot be formed on a 64-bit host. Tasks run
+  on host contexts created on their first context switch; hence, only their taskHandle structs are defined.*/
+#undef TASK_DEFINE
+#define TASK_DEFINE(name, stackSize, taskEntryFunction, taskParams, taskPriority)  \
+    typedef char name##PriorityOutOfRange                                          \
+        [((taskPriority) < TASK_PRIORITY_LEVELS) ? 1 : -1];                        \
+    void taskEntryFunction(void *);                                                \
+    taskHandleType name = {                                                        \
+        .stackPointer = 0,                                                         \
+        .priority = taskPriority,                                                  \
+        .taskEntry = taskEntryFunction,                                            \
+        .params = taskParams,                                                      \
+        .remainingSleepTicks = 0,                                                  \
+        .status = TASK_STATUS_READY,                                               \
+        .blockedReason = BLOCK_REASON_NONE,                                        \
+        .wakeupReason = WAKEUP_REASON_NONE,                                        \
+        .timeSliceTicks = TASK_TIME_SLICE_TICKS,                                   \
+        .remainingTimeSliceTicks = TASK_TIME_SLICE_TICKS,                          \
+        .notifyValue = 0,                                                          \
+        .notifyPending = false,                                                    \
+        .pWaitData = NULL,                                                         \
+        .schedNode = {.pTask = &name, .nextTaskNode = NULL, .prevTaskNode = NULL}, \
+        .waitNode = {.pTask = &name, .nextTaskNode = NULL, .prevTaskNode = NULL}}
+
+#include "taskQueue/taskQueue.c"
+#include "readyQueue/readyQueue.c"
+#include "task/task.c"
+#include "timer/timer.c"
+#include "tickSource/tickSourceSim.c"
+#include "scheduler/scheduler.c"
+#include "hrTimer/hrTimer.c"
+#include "hrTimer/hrTimerSim.c"
+
+SCB_Type hostSCB;
+SysTick_Type hostSysTick;
+uint32_t SystemCoreClock = 64000000;
+uint32_t hostPrimask = 0;
+
+/*Process stack pointer, read by SVC_Handler only, which is never called on the host*/
+uint32_t hostPSP = 0;
+
+#define HOST_MAX_TASKS 16
+
+#define HOST_TASK_STACK_SIZE (64 * 1024)
+
+typedef struct
+{
+    taskHandleType *pTask;
+    ucontext_t context;
+} hostTaskContextType;
+
+static hostTaskContextType hostTaskContexts[HOST_MAX_TASKS];
+
+static uint32_t hostTaskCount = 0;
+
+static bool hostSchedulerRunning = false;
+
+static bool hostHandlerMode = false;
+
+/*CPU cycles run by the tasks since the last tick boundary*/
+static uint32_t hostTickCycles = 0;
+
+/*Number of context switches performed since the scheduler was started*/
+static uint64_t hostContextSwitches = 0;
+
+/**
+ * @brief Make the idle task the running task, as the scheduler does once all the other tasks are blocked.
+ */
+static inline void hostKernelInit()
+{
+    taskPool.currentTask = currentTask = &idleTask;
+
+    idleTask.status = TASK_STATUS_RUNNING;
+}
+
+/**
+ * @brief Run the entry function of the task switched to for the first time.
+ */
+static void hostTaskEntry()
+{
+    currentTask->taskEntry(currentTask->params);
+
+    taskExitFunction();
+}
+
+/**
+ * @brief Get host context of the task, which is created on first use. Context of the task started by
+ * schedulerStart is saved on the main stack at its first context switch.
+ *
+ * @param pTask Pointer to taskHandle struct
+ * @return Pointer to host context of the task
+ */
+static ucontext_t *hostTaskContext(taskHandleType *pTask)
+{
+    for (uint32_t i = 0; i < hostTaskCount; i++)
+    {
+        if (hostTaskContexts[i].pTask == pTask)
+        {
+            return &hostTaskContexts[i].context;
+        }
+    }
+
+    assert(hostTaskCount < HOST_MAX_TASKS);
+
+    hostTaskContextType *pTaskContext = &hostTaskContexts[hostTaskCount++];
+
+    pTaskContext->pTask = pTask;
+    getcontext(&pTaskContext->context);
+    pTaskContext->context.uc_stack.ss_sp = malloc(HOST_TASK_STACK_SIZE);
+    pTaskContext->context.uc_stack.ss_size = HOST_TASK_STACK_SIZE;
+    pTaskContext->context.uc_link = NULL;
+    makecontext(&pTaskContext->context, hostTaskEntry, 0);
+
+    return &pTaskContext->context;
+}
+
+/**
+ * @brief Host PendSV handler. Saves the context of currentTask and restores the one of nextTask.
+ */
+static void hostPendSV()
+{
+    taskHandleType *pPrevTask = currentTask;
+
+    SCB->ICSR &= ~SCB_ICSR_PENDSVSET_Msk;
+
+    currentTask = nextTask;
+
+    if (pPrevTask != currentTask)
+    {
+        hostContextSwitches++;
+
+        swapcontext(hostTaskContext(pPrevTask), hostTaskContext(currentTask));
+    }
+}
+
+/**
+ * @brief Take pending interrupts once they are unmasked in thread mode: the tick interrupt of the simulated tick
+ * source first, then PendSV, which has the lowest priority. Nothing is taken until hostSchedulerStart is called.
+ */
+void hostInterruptsTake()
+{
+    if (!hostSchedulerRunning || hostHandlerMode || hostPrimask)
+    {
+        return;
+    }
+
+    bool tickPending = tickSourceSimTickPending();
+
+    /*Idle task which does not suppress ticks spins until the next tick interrupt*/
+    if (!tickPending && currentTask == &idleTask && !(SCB->ICSR & SCB_ICSR_PENDSVSET_Msk))
+    {
+        tickSourceSimAdvanceTick();
+
+        tickPending = tickSourceSimTickPending();
+    }
+
+    if (tickPending)
+    {
+        hostHandlerMode = true;
+        SYSTICK_HANDLER();
+        hostHandlerMode = false;
+    }
+
+    if (SCB->ICSR & SCB_ICSR_PENDSVSET_Msk)
+    {
+        hostPendSV();
+    }
+}
+
+/**
+ * @brief Account CPU cycles spent by the running task. Tick interrupts that fall into them are taken, which
+ * may switch to another task before this function returns.
+ *
+ * @param cycles Number of CPU cycles
+ */
+static inline void hostTaskRun(uint32_t cycles)
+{
+    assert(hostPrimask == 0);
+
+    hostTickCycles += cycles;
+
+    while (hostTickCycles >= OS_INTERVAL_CPU_TICKS)
+    {
+        hostTickCycles -= OS_INTERVAL_CPU_TICKS;
+
+        tickSourceSimAdvanceTick();
+        hostInterruptsTake();
+    }
+}
+
+/**
+ * @brief Start the scheduler on the host. Tasks must be started with taskStart before; this function never returns.
+ */
+static inline void hostSchedulerStart()
+{
+    hostSchedulerRunning = true;
+
+    schedulerStart();
+}
@@ -0,0 +1,76 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __SANO_RTOS_HOST_TEST_H
+#define __SANO_RTOS_HOST_TEST_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+/*Number of failed checks of the running test program*/
+static unsigned int hostTestFailures = 0;
+
+/**
+ * @brief Check that actual equals expected. A failed check is reported and counted; the test goes on.
+ */
+#define TEST_CHECK_EQUAL(actual, expected)                                                         \
+    do                                                                                             \
+    {                                                                                              \
+        unsigned long long actualValue = (unsigned long long)(actual);                             \
+        unsigned long long expectedValue = (unsigned long long)(expected);                         \
+        if (actualValue != expectedValue)                                                          \
+        {                                                                                          \
+            printf("%s:%d: %s is %llu, expected %llu\n", __FILE__, __LINE__, #actual, actualValue, \
+                   expectedValue);                                                                 \
+            hostTestFailures++;                                                                    \
+        }                                                                                          \
+    } while (0)
+
+/**
+ * @brief Report the result of the test program.
+ *
+ * @param name Name of the test program
+ * @return Exit status of the test program
+ */
+static inline int hostTestResult(const char *name)
+{
+    printf("%s: %s\n", name, (hostTestFailures == 0) ? "PASS" : "FAIL");
+
+    return (hostTestFailures == 0) ? 0 : 1;
+}
+
+/**
+ * @brief Get monotonic time of the host in nanoseconds, used by the benchmarks.
+ */
+static inline uint64_t hostTestNanoseconds()
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+#endif
@@ -0,0 +1,56 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Host configuration. The kernel configuration is used as is, except for the options which select simulated
+ * backends so that the kernel runs on a host.
+ */
+
+#ifndef __SANO_RTOS_HOST_OS_CONFIG_H
+#define __SANO_RTOS_HOST_OS_CONFIG_H
+
+#include "../../osConfig.h"
+
+#undef OS_TICKLESS_IDLE
+#define OS_TICKLESS_IDLE 1
+
+#undef OS_TICK_SOURCE_SIM
+#define OS_TICK_SOURCE_SIM 1
+
+#undef OS_HR_TIMER_SIM
+#define OS_HR_TIMER_SIM 1
+
+/*High resolution timer enabled by the tests which exercise it*/
+#ifdef HOST_OS_HR_TIMER
+#undef OS_HR_TIMER
+#define OS_HR_TIMER HOST_OS_HR_TIMER
+#endif
+
+/*Preemption policy selected by the benchmarks that compare both*/
+#ifdef HOST_TASK_PREEMPT_ON_EQUAL_PRIORITY
+#undef TASK_PREEMPT_ON_EQUAL_PRIORITY
+#define TASK_PREEMPT_ON_EQUAL_PRIORITY HOST_TASK_PREEMPT_ON_EQUAL_PRIORITY
+#endif
+
+#endif
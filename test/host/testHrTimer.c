@@ -0,0 +1,271 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * High resolution timer behaviour on the simulated counter with the scheduler running. The test task plays the role
+ * of the counter hardware: it advances the simulated counter, which calls the compare handler at the exact counter
+ * value. A sleeper task of higher priority blocks in microsecond sleeps, so that the test task can check when it is
+ * woken up.
+ */
+
+#include <stdlib.h>
+#include "hostTest.h"
+#include "hostKernel.c"
+
+#define TEST_TASK_PRIORITY 5
+
+#define SLEEPER_TASK_PRIORITY 3
+
+#define TEST_TIMER_COUNT 4
+
+/*Expiries recorded by the timeout handler, in the order they happen*/
+static hrTimerNodeType *expiredTimers[TEST_TIMER_COUNT];
+
+static uint32_t expiryCounts[TEST_TIMER_COUNT];
+
+static uint32_t expiredCount = 0;
+
+/*Sleep requested from the sleeper task, along with its results*/
+static uint32_t sleepTimeUS;
+
+static uint32_t sleepDoneCount;
+
+static uint32_t sleepDoneTick;
+
+static bool sleepDone;
+
+HR_TIMER_DEFINE(timerA, testTimeoutHandler, NULL);
+
+HR_TIMER_DEFINE(timerB, testTimeoutHandler, NULL);
+
+HR_TIMER_DEFINE(timerC, testTimeoutHandler, NULL);
+
+HR_TIMER_DEFINE(timerD, testTimeoutHandler, NULL);
+
+TASK_DEFINE(sleeperTask, 1024, sleeperTaskHandler, NULL, SLEEPER_TASK_PRIORITY);
+
+TASK_DEFINE(testTask, 4096, testTaskHandler, NULL, TEST_TASK_PRIORITY);
+
+void testTimeoutHandler(hrTimerNodeType *pHrTimerNode, void *arg)
+{
+    (void)arg;
+
+    assert(expiredCount < TEST_TIMER_COUNT);
+
+    expiredTimers[expiredCount] = pHrTimerNode;
+    expiryCounts[expiredCount] = hrTimerPortCounterGet();
+    expiredCount++;
+}
+
+void sleeperTaskHandler(void *params)
+{
+    (void)params;
+
+    while (1)
+    {
+        taskNotifyWait(0, NULL, TASK_MAX_WAIT);
+
+        taskSleepUS(sleepTimeUS);
+
+        sleepDoneCount = hrTimerPortCounterGet();
+        sleepDoneTick = osTicksGet();
+        sleepDone = true;
+    }
+}
+
+/**
+ * @brief Advance the simulated counter from the compare interrupt. Context switch requested by the compare handler
+ * is taken on return to thread mode.
+ *
+ * @param counts Number of counts to advance the counter by
+ */
+static void counterAdvance(uint32_t counts)
+{
+    hostHandlerMode = true;
+    hrTimerSimAdvance(counts);
+    hostHandlerMode = false;
+
+    hostInterruptsTake();
+}
+
+/**
+ * @brief Run a sleep on the sleeper task. The sleeper task preempts the test task and runs until it blocks.
+ */
+static void sleeperStart(uint32_t timeUS)
+{
+    sleepTimeUS = timeUS;
+    sleepDone = false;
+
+    taskNotify(&sleeperTask, 0, TASK_NOTIFY_INCREMENT);
+}
+
+/**
+ * @brief Timers expire in order of their expiry; timers with equal expiry in the order they were started. The compare
+ * channel is armed for the earliest running timer and follows it as timers are stopped.
+ */
+static void testStartStopOrder()
+{
+    uint32_t startCount = hrTimerPortCounterGet();
+
+    expiredCount = 0;
+
+    TEST_CHECK_EQUAL(hrTimerStart(&timerA, 300), RET_SUCCESS);
+    TEST_CHECK_EQUAL(simCompareValue, startCount + US_TO_HR_TIMER_COUNTS(300));
+
+    TEST_CHECK_EQUAL(hrTimerStart(&timerB, 100), RET_SUCCESS);
+    TEST_CHECK_EQUAL(simCompareValue, startCount + US_TO_HR_TIMER_COUNTS(100));
+
+    TEST_CHECK_EQUAL(hrTimerStart(&timerC, 300), RET_SUCCESS);
+    TEST_CHECK_EQUAL(hrTimerStart(&timerD, 50), RET_SUCCESS);
+    TEST_CHECK_EQUAL(hrTimerStart(&timerD, 50), RET_ALREADYACTIVE);
+    TEST_CHECK_EQUAL(simCompareValue, startCount + US_TO_HR_TIMER_COUNTS(50));
+
+    /*Stopping the earliest timer re-arms the compare channel for the next one*/
+    TEST_CHECK_EQUAL(hrTimerStop(&timerD), RET_SUCCESS);
+    TEST_CHECK_EQUAL(hrTimerStop(&timerD), RET_NOTACTIVE);
+    TEST_CHECK_EQUAL(simCompareValue, startCount + US_TO_HR_TIMER_COUNTS(100));
+
+    counterAdvance(US_TO_HR_TIMER_COUNTS(100) - 1);
+    TEST_CHECK_EQUAL(expiredCount, 0);
+
+    counterAdvance(1);
+    TEST_CHECK_EQUAL(expiredCount, 1);
+    TEST_CHECK_EQUAL(timerB.isRunning, false);
+    TEST_CHECK_EQUAL(simCompareValue, startCount + US_TO_HR_TIMER_COUNTS(300));
+
+    /*Both timers of equal expiry are handled by a single compare interrupt*/
+    counterAdvance(US_TO_HR_TIMER_COUNTS(500));
+    TEST_CHECK_EQUAL(expiredCount, 3);
+    TEST_CHECK_EQUAL(simCompareEnabled, false);
+
+    TEST_CHECK_EQUAL(expiredTimers[0], &timerB);
+    TEST_CHECK_EQUAL(expiryCounts[0], startCount + US_TO_HR_TIMER_COUNTS(100));
+    TEST_CHECK_EQUAL(expiredTimers[1], &timerA);
+    TEST_CHECK_EQUAL(expiryCounts[1], startCount + US_TO_HR_TIMER_COUNTS(300));
+    TEST_CHECK_EQUAL(expiredTimers[2], &timerC);
+    TEST_CHECK_EQUAL(expiryCounts[2], startCount + US_TO_HR_TIMER_COUNTS(300));
+
+    /*Stopping the only running timer disables the compare channel*/
+    TEST_CHECK_EQUAL(hrTimerStart(&timerA, 100), RET_SUCCESS);
+    TEST_CHECK_EQUAL(hrTimerStop(&timerA), RET_SUCCESS);
+    TEST_CHECK_EQUAL(simCompareEnabled, false);
+
+    counterAdvance(US_TO_HR_TIMER_COUNTS(200));
+    TEST_CHECK_EQUAL(expiredCount, 3);
+}
+
+/**
+ * @brief Compare value which the counter has already reached raises the interrupt at once, and the compare handler
+ * handles timers across the wrap around of the counter.
+ */
+static void testCompareHandler()
+{
+    expiredCount = 0;
+
+    TEST_CHECK_EQUAL(hrTimerStart(&timerA, 0), RET_SUCCESS);
+    TEST_CHECK_EQUAL(expiredCount, 0);
+
+    counterAdvance(0);
+    TEST_CHECK_EQUAL(expiredCount, 1);
+    TEST_CHECK_EQUAL(timerA.isRunning, false);
+
+    /*Move the counter close to the wrap around*/
+    counterAdvance(UINT32_MAX - hrTimerPortCounterGet() - US_TO_HR_TIMER_COUNTS(50));
+
+    uint32_t startCount = hrTimerPortCounterGet();
+
+    TEST_CHECK_EQUAL(hrTimerStart(&timerB, 100), RET_SUCCESS);
+    TEST_CHECK_EQUAL(hrTimerStart(&timerC, 20), RET_SUCCESS);
+
+    counterAdvance(US_TO_HR_TIMER_COUNTS(200));
+    TEST_CHECK_EQUAL(expiredCount, 3);
+    TEST_CHECK_EQUAL(expiredTimers[1], &timerC);
+    TEST_CHECK_EQUAL(expiryCounts[1], startCount + US_TO_HR_TIMER_COUNTS(20));
+    TEST_CHECK_EQUAL(expiredTimers[2], &timerB);
+    TEST_CHECK_EQUAL(expiryCounts[2], startCount + US_TO_HR_TIMER_COUNTS(100));
+}
+
+/**
+ * @brief Sleeps shorter than a tick wake up at the exact counter value without waiting for a tick; longer sleeps are
+ * rounded down to whole ticks.
+ */
+static void testSleep()
+{
+    uint32_t startCount = hrTimerPortCounterGet();
+    uint32_t startTick = osTicksGet();
+
+    sleeperStart(300);
+    TEST_CHECK_EQUAL(sleeperTask.status, TASK_STATUS_BLOCKED);
+
+    counterAdvance(US_TO_HR_TIMER_COUNTS(300) - 1);
+    TEST_CHECK_EQUAL(sleepDone, false);
+
+    /*Sleeper task preempts the test task on return from the compare interrupt*/
+    counterAdvance(1);
+    TEST_CHECK_EQUAL(sleepDone, true);
+    TEST_CHECK_EQUAL(sleepDoneCount, startCount + US_TO_HR_TIMER_COUNTS(300));
+    TEST_CHECK_EQUAL(sleepDoneTick, startTick);
+    TEST_CHECK_EQUAL(simCompareEnabled, false);
+
+    /*Sleep of no counts returns at once*/
+    sleeperStart(0);
+    TEST_CHECK_EQUAL(sleepDone, true);
+    TEST_CHECK_EQUAL(simCompareEnabled, false);
+
+    /*Sleep of a tick or more uses the OS tick and is rounded down to whole ticks*/
+    sleeperStart(2 * OS_TICK_INTERVAL_US + OS_TICK_INTERVAL_US / 2);
+    TEST_CHECK_EQUAL(sleeperTask.status, TASK_STATUS_BLOCKED);
+    TEST_CHECK_EQUAL(simCompareEnabled, false);
+
+    startTick = osTicksGet();
+
+    taskSleep(3);
+
+    TEST_CHECK_EQUAL(sleepDone, true);
+    TEST_CHECK_EQUAL(sleepDoneTick - startTick, 2);
+}
+
+void testTaskHandler(void *params)
+{
+    (void)params;
+
+    testStartStopOrder();
+
+    testCompareHandler();
+
+    testSleep();
+
+    exit(hostTestResult("testHrTimer"));
+}
+
+int main()
+{
+    taskStart(&sleeperTask);
+
+    taskStart(&testTask);
+
+    hostSchedulerStart();
+
+    return 0;
+}
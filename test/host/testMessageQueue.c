@@ -0,0 +1,494 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Message queue behaviour with the scheduler running. The test task runs the test cases; helper tasks of higher
+ * priority run jobs which block on the queue, so that the test task can check when they are unblocked.
+ */
+
+#include <stdlib.h>
+#include "hostTest.h"
+#include "hostKernel.c"
+#include "messageQueue/messageQueue.c"
+
+#define TEST_TASK_PRIORITY 5
+
+#define HELPER_TASK_PRIORITY 3
+
+#define TEST_QUEUE_LENGTH 4
+
+#define TICK_CYCLES OS_INTERVAL_CPU_TICKS
+
+typedef struct helper helperType;
+
+/*Job run by a helper task, along with its arguments and results*/
+struct helper
+{
+    void (*job)(helperType *pHelper);
+    uint32_t value;
+    uint32_t waitTicks;
+    int retCode;
+    uint32_t doneTick;
+    bool done;
+    uint32_t items[TEST_QUEUE_LENGTH];
+};
+
+static helperType helpers[2];
+
+MSG_QUEUE_DEFINE(testQueue, TEST_QUEUE_LENGTH, sizeof(uint32_t));
+
+MSG_QUEUE_DEFINE_POW2(pow2Queue, TEST_QUEUE_LENGTH, sizeof(uint32_t));
+
+TASK_DEFINE(helperTask0, 1024, helperTaskHandler, &helpers[0], HELPER_TASK_PRIORITY);
+
+TASK_DEFINE(helperTask1, 1024, helperTaskHandler, &helpers[1], HELPER_TASK_PRIORITY);
+
+TASK_DEFINE(testTask, 4096, testTaskHandler, NULL, TEST_TASK_PRIORITY);
+
+static taskHandleType *const helperTasks[] = {&helperTask0, &helperTask1};
+
+void helperTaskHandler(void *params)
+{
+    helperType *pHelper = params;
+
+    while (1)
+    {
+        taskNotifyWait(0, NULL, TASK_MAX_WAIT);
+
+        pHelper->job(pHelper);
+
+        pHelper->doneTick = osTicksGet();
+        pHelper->done = true;
+    }
+}
+
+/**
+ * @brief Run the job on the helper task. The helper task preempts the test task and runs until the job
+ * completes or blocks.
+ */
+static void helperStart(uint32_t index, void (*job)(helperType *), uint32_t value, uint32_t waitTicks)
+{
+    helpers[index].job = job;
+    helpers[index].value = value;
+    helpers[index].waitTicks = waitTicks;
+    helpers[index].done = false;
+
+    taskNotify(helperTasks[index], 0, TASK_NOTIFY_INCREMENT);
+}
+
+static void helperSend(helperType *pHelper)
+{
+    pHelper->retCode = msgQueueSend(&testQueue, &pHelper->value, pHelper->waitTicks);
+}
+
+static void helperReceive(helperType *pHelper)
+{
+    pHelper->retCode = msgQueueReceive(&testQueue, &pHelper->value, pHelper->waitTicks);
+}
+
+/*Receive at least value and up to TEST_QUEUE_LENGTH items; value is assigned the number of items received*/
+static void helperReceiveN(helperType *pHelper)
+{
+    pHelper->retCode = msgQueueReceiveN(&testQueue, pHelper->items, pHelper->value, TEST_QUEUE_LENGTH, &pHelper->value,
+                                        pHelper->waitTicks);
+}
+
+static void helperPow2Send(helperType *pHelper)
+{
+    pHelper->retCode = pow2QueueSend(&pHelper->value, pHelper->waitTicks);
+}
+
+static void helperPow2Receive(helperType *pHelper)
+{
+    pHelper->retCode = pow2QueueReceive(&pHelper->value, pHelper->waitTicks);
+}
+
+static void testSend(uint32_t value, int expected)
+{
+    TEST_CHECK_EQUAL(msgQueueSend(&testQueue, &value, TASK_NO_WAIT), expected);
+}
+
+static void testReceive(uint32_t expected)
+{
+    uint32_t value = 0;
+
+    TEST_CHECK_EQUAL(msgQueueReceive(&testQueue, &value, TASK_NO_WAIT), RET_SUCCESS);
+    TEST_CHECK_EQUAL(value, expected);
+}
+
+/**
+ * @brief Check that the queue is empty and holds no reserved or peeked slot.
+ */
+static void testQueueEmpty()
+{
+    uint32_t value;
+
+    TEST_CHECK_EQUAL(msgQueueReceive(&testQueue, &value, TASK_NO_WAIT), RET_EMPTY);
+    TEST_CHECK_EQUAL(testQueue.itemCount, 0);
+    TEST_CHECK_EQUAL(testQueue.reservedSlots, 0);
+    TEST_CHECK_EQUAL(testQueue.peekedSlots, 0);
+}
+
+/**
+ * @brief Items sent while a slot is reserved are queued behind it, from tasks and ISRs alike. The reserved slot
+ * is occupied; a consumer stays blocked until the reserved slot is committed.
+ */
+static void testReserveCommit()
+{
+    uint32_t *pSlot;
+    uint32_t value = 3;
+
+    TEST_CHECK_EQUAL(msgQueueReserve(&testQueue, (void **)&pSlot, TASK_NO_WAIT), RET_SUCCESS);
+    *pSlot = 1;
+
+    TEST_CHECK_EQUAL(msgQueueReserve(&testQueue, (void **)&pSlot, TASK_NO_WAIT), RET_BUSY);
+
+    helperStart(0, helperReceive, 0, TASK_MAX_WAIT);
+    TEST_CHECK_EQUAL(helpers[0].done, false);
+
+    testSend(2, RET_SUCCESS);
+    TEST_CHECK_EQUAL(msgQueueSendFromISR(&testQueue, &value), RET_SUCCESS);
+    TEST_CHECK_EQUAL(helpers[0].done, false);
+
+    testSend(4, RET_SUCCESS);
+    testSend(5, RET_FULL);
+    TEST_CHECK_EQUAL(msgQueueSendFromISR(&testQueue, &value), RET_FULL);
+
+    TEST_CHECK_EQUAL(msgQueueCommit(&testQueue), RET_SUCCESS);
+    TEST_CHECK_EQUAL(msgQueueCommit(&testQueue), RET_INVAL);
+
+    TEST_CHECK_EQUAL(helpers[0].done, true);
+    TEST_CHECK_EQUAL(helpers[0].retCode, RET_SUCCESS);
+    TEST_CHECK_EQUAL(helpers[0].value, 1);
+
+    testReceive(2);
+    testReceive(3);
+    testReceive(4);
+    testQueueEmpty();
+}
+
+/**
+ * @brief Items behind the peeked item are received while it is peeked, but their slots are freed only once the
+ * peeked item is released.
+ */
+static void testPeekRelease()
+{
+    uint32_t *pSlot;
+
+    for (uint32_t value = 1; value <= TEST_QUEUE_LENGTH; value++)
+    {
+        testSend(value, RET_SUCCESS);
+    }
+
+    TEST_CHECK_EQUAL(msgQueuePeekSlot(&testQueue, (void **)&pSlot, TASK_NO_WAIT), RET_SUCCESS);
+    TEST_CHECK_EQUAL(*pSlot, 1);
+
+    TEST_CHECK_EQUAL(msgQueuePeekSlot(&testQueue, (void **)&pSlot, TASK_NO_WAIT), RET_BUSY);
+
+    testReceive(2);
+
+    helperStart(0, helperSend, 5, TASK_MAX_WAIT);
+    TEST_CHECK_EQUAL(helpers[0].done, false);
+
+    TEST_CHECK_EQUAL(msgQueueRelease(&testQueue), RET_SUCCESS);
+    TEST_CHECK_EQUAL(msgQueueRelease(&testQueue), RET_INVAL);
+
+    TEST_CHECK_EQUAL(helpers[0].done, true);
+    TEST_CHECK_EQUAL(helpers[0].retCode, RET_SUCCESS);
+
+    testReceive(3);
+    testReceive(4);
+    testReceive(5);
+    testQueueEmpty();
+}
+
+/**
+ * @brief Producer which is woken up but finds the queue full again blocks for the rest of its wait time only.
+ */
+static void testSendTimeout()
+{
+    uint32_t value;
+
+    for (value = 1; value <= TEST_QUEUE_LENGTH; value++)
+    {
+        testSend(value, RET_SUCCESS);
+    }
+
+    uint32_t startTick = osTicksGet();
+
+    helperStart(0, helperSend, value, 10);
+    TEST_CHECK_EQUAL(helpers[0].done, false);
+
+    hostTaskRun(5 * TICK_CYCLES);
+
+    /*Free slot is taken again before the woken up producer runs*/
+    schedulerLock();
+    testReceive(1);
+    testSend(value, RET_SUCCESS);
+    schedulerUnlock();
+
+    TEST_CHECK_EQUAL(helpers[0].done, false);
+
+    taskSleep(20);
+
+    TEST_CHECK_EQUAL(helpers[0].done, true);
+    TEST_CHECK_EQUAL(helpers[0].retCode, RET_TIMEOUT);
+    TEST_CHECK_EQUAL(helpers[0].doneTick - startTick, 10);
+
+    for (value = 2; value <= TEST_QUEUE_LENGTH + 1; value++)
+    {
+        testReceive(value);
+    }
+    testQueueEmpty();
+}
+
+/**
+ * @brief Item sent to an empty queue is copied directly to a blocked consumer, bypassing the queue buffer. Consumer
+ * which is suspended while waiting is not blocked; it gets the item from the queue buffer once resumed.
+ */
+static void testHandoff()
+{
+    uint32_t writeIndex = testQueue.writeIndex;
+
+    helperStart(0, helperReceive, 0, TASK_MAX_WAIT);
+    helperStart(1, helperReceive, 0, TASK_MAX_WAIT);
+
+    testSend(7, RET_SUCCESS);
+
+    TEST_CHECK_EQUAL(helpers[0].done, true);
+    TEST_CHECK_EQUAL(helpers[0].value, 7);
+    TEST_CHECK_EQUAL(helpers[1].done, false);
+    TEST_CHECK_EQUAL(testQueue.writeIndex, writeIndex);
+    TEST_CHECK_EQUAL(testQueue.itemCount, 0);
+
+    taskSuspend(&helperTask1);
+
+    testSend(8, RET_SUCCESS);
+
+    TEST_CHECK_EQUAL(helpers[1].done, false);
+    TEST_CHECK_EQUAL(testQueue.itemCount, 1);
+
+    TEST_CHECK_EQUAL(taskResume(&helperTask1), RET_SUCCESS);
+
+    /*Resumed task does not preempt the current task by itself*/
+    taskYield();
+
+    TEST_CHECK_EQUAL(helpers[1].done, true);
+    TEST_CHECK_EQUAL(helpers[1].retCode, RET_SUCCESS);
+    TEST_CHECK_EQUAL(helpers[1].value, 8);
+    testQueueEmpty();
+}
+
+/**
+ * @brief msgQueueSendN sends as many items as fit, and waits only if none fits.
+ */
+static void testSendN()
+{
+    const uint32_t items[] = {10, 11, 12};
+    uint32_t received[TEST_QUEUE_LENGTH + 1];
+    uint32_t count;
+
+    for (uint32_t value = 1; value < TEST_QUEUE_LENGTH; value++)
+    {
+        testSend(value, RET_SUCCESS);
+    }
+
+    TEST_CHECK_EQUAL(msgQueueSendN(&testQueue, items, 3, &count, TASK_NO_WAIT), RET_SUCCESS);
+    TEST_CHECK_EQUAL(count, 1);
+
+    TEST_CHECK_EQUAL(msgQueueSendN(&testQueue, items, 3, &count, TASK_NO_WAIT), RET_FULL);
+    TEST_CHECK_EQUAL(count, 0);
+
+    uint32_t startTick = osTicksGet();
+
+    TEST_CHECK_EQUAL(msgQueueSendN(&testQueue, items, 3, &count, 5), RET_TIMEOUT);
+    TEST_CHECK_EQUAL(count, 0);
+    TEST_CHECK_EQUAL(osTicksGet() - startTick, 5);
+
+    TEST_CHECK_EQUAL(msgQueueReceiveN(&testQueue, received, 1, TEST_QUEUE_LENGTH + 1, &count, TASK_NO_WAIT), RET_SUCCESS);
+    TEST_CHECK_EQUAL(count, TEST_QUEUE_LENGTH);
+    TEST_CHECK_EQUAL(received[0], 1);
+    TEST_CHECK_EQUAL(received[TEST_QUEUE_LENGTH - 1], 10);
+    testQueueEmpty();
+}
+
+/**
+ * @brief msgQueueReceiveN receives the available items if the wait for minCount items times out.
+ */
+static void testReceiveN()
+{
+    uint32_t received[TEST_QUEUE_LENGTH];
+    uint32_t count;
+
+    TEST_CHECK_EQUAL(msgQueueReceiveN(&testQueue, received, 1, TEST_QUEUE_LENGTH, &count, TASK_NO_WAIT), RET_EMPTY);
+    TEST_CHECK_EQUAL(count, 0);
+
+    testSend(1, RET_SUCCESS);
+    testSend(2, RET_SUCCESS);
+
+    uint32_t startTick = osTicksGet();
+
+    TEST_CHECK_EQUAL(msgQueueReceiveN(&testQueue, received, 3, TEST_QUEUE_LENGTH, &count, 5), RET_TIMEOUT);
+    TEST_CHECK_EQUAL(osTicksGet() - startTick, 5);
+    TEST_CHECK_EQUAL(count, 2);
+    TEST_CHECK_EQUAL(received[0], 1);
+    TEST_CHECK_EQUAL(received[1], 2);
+    testQueueEmpty();
+}
+
+/**
+ * @brief Consumer waiting for several items does not hold up the consumer waiting behind it for a single item.
+ */
+static void testReceiveNWakeup()
+{
+    helperStart(0, helperReceiveN, 3, TASK_MAX_WAIT);
+    helperStart(1, helperReceive, 0, TASK_MAX_WAIT);
+
+    testSend(1, RET_SUCCESS);
+
+    TEST_CHECK_EQUAL(helpers[0].done, false);
+    TEST_CHECK_EQUAL(helpers[1].done, true);
+    TEST_CHECK_EQUAL(helpers[1].value, 1);
+
+    testSend(2, RET_SUCCESS);
+    testSend(3, RET_SUCCESS);
+    TEST_CHECK_EQUAL(helpers[0].done, false);
+
+    testSend(4, RET_SUCCESS);
+    TEST_CHECK_EQUAL(helpers[0].done, true);
+    TEST_CHECK_EQUAL(helpers[0].retCode, RET_SUCCESS);
+    TEST_CHECK_EQUAL(helpers[0].value, 3);
+    TEST_CHECK_EQUAL(helpers[0].items[0], 2);
+    TEST_CHECK_EQUAL(helpers[0].items[2], 4);
+    testQueueEmpty();
+}
+
+/**
+ * @brief Indices of a power of two queue are masked as items go around the ring buffer several times.
+ */
+static void testPow2Wrap()
+{
+    uint32_t value;
+
+    TEST_CHECK_EQUAL(pow2Queue.indexMask, TEST_QUEUE_LENGTH - 1);
+
+    for (uint32_t i = 0; i < 3 * TEST_QUEUE_LENGTH; i++)
+    {
+        TEST_CHECK_EQUAL(pow2QueueSend(&i, TASK_NO_WAIT), RET_SUCCESS);
+        TEST_CHECK_EQUAL(pow2Queue.writeIndex, (i + 1) % TEST_QUEUE_LENGTH);
+
+        TEST_CHECK_EQUAL(pow2QueueReceive(&value, TASK_NO_WAIT), RET_SUCCESS);
+        TEST_CHECK_EQUAL(pow2Queue.readIndex, (i + 1) % TEST_QUEUE_LENGTH);
+        TEST_CHECK_EQUAL(value, i);
+    }
+
+    /*Start the next test with the indices of the ring buffer in the middle*/
+    TEST_CHECK_EQUAL(pow2QueueSend(&value, TASK_NO_WAIT), RET_SUCCESS);
+    TEST_CHECK_EQUAL(pow2QueueReceive(&value, TASK_NO_WAIT), RET_SUCCESS);
+}
+
+/**
+ * @brief Generated functions fall back to the generic ones whenever a task has to be unblocked or the queue is full or
+ * empty; hence, they wake up the waiting tasks and follow the same blocking semantics.
+ */
+static void testPow2Functions()
+{
+    uint32_t value;
+
+    helperStart(0, helperPow2Receive, 0, TASK_MAX_WAIT);
+
+    value = 100;
+    TEST_CHECK_EQUAL(pow2QueueSend(&value, TASK_NO_WAIT), RET_SUCCESS);
+
+    TEST_CHECK_EQUAL(helpers[0].done, true);
+    TEST_CHECK_EQUAL(helpers[0].retCode, RET_SUCCESS);
+    TEST_CHECK_EQUAL(helpers[0].value, 100);
+
+    for (value = 0; value < TEST_QUEUE_LENGTH - 1; value++)
+    {
+        TEST_CHECK_EQUAL(pow2QueueSend(&value, TASK_NO_WAIT), RET_SUCCESS);
+    }
+    TEST_CHECK_EQUAL(pow2QueueSendFromISR(&value), RET_SUCCESS);
+
+    TEST_CHECK_EQUAL(pow2QueueSend(&value, TASK_NO_WAIT), RET_FULL);
+    TEST_CHECK_EQUAL(pow2QueueSendFromISR(&value), RET_FULL);
+
+    helperStart(0, helperPow2Send, TEST_QUEUE_LENGTH, TASK_MAX_WAIT);
+    TEST_CHECK_EQUAL(helpers[0].done, false);
+
+    TEST_CHECK_EQUAL(pow2QueueReceive(&value, TASK_NO_WAIT), RET_SUCCESS);
+    TEST_CHECK_EQUAL(value, 0);
+
+    TEST_CHECK_EQUAL(helpers[0].done, true);
+    TEST_CHECK_EQUAL(helpers[0].retCode, RET_SUCCESS);
+
+    for (uint32_t i = 1; i <= TEST_QUEUE_LENGTH; i++)
+    {
+        TEST_CHECK_EQUAL(pow2QueueReceive(&value, TASK_NO_WAIT), RET_SUCCESS);
+        TEST_CHECK_EQUAL(value, i);
+    }
+
+    uint32_t startTick = osTicksGet();
+
+    TEST_CHECK_EQUAL(pow2QueueReceive(&value, 3), RET_TIMEOUT);
+    TEST_CHECK_EQUAL(osTicksGet() - startTick, 3);
+}
+
+void testTaskHandler(void *params)
+{
+    (void)params;
+
+    testReserveCommit();
+
+    testPeekRelease();
+
+    testSendTimeout();
+
+    testHandoff();
+
+    testSendN();
+
+    testReceiveN();
+
+    testReceiveNWakeup();
+
+    testPow2Wrap();
+
+    testPow2Functions();
+
+    exit(hostTestResult("testMessageQueue"));
+}
+
+int main()
+{
+    taskStart(&helperTask0);
+
+    taskStart(&helperTask1);
+
+    taskStart(&testTask);
+
+    hostSchedulerStart();
+
+    return 0;
+}
@@ -0,0 +1,232 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * SPSC ring blocking and wakeup with the scheduler running. A consumer task of higher priority pops from the ring,
+ * so that the test task can check when it is woken up. Pops are started through a semaphore; hence, the notification
+ * of the consumer task is left to the test cases.
+ */
+
+#include <stdlib.h>
+#include "hostTest.h"
+#include "hostKernel.c"
+#include "semaphore/semaphore.c"
+#include "spscRing/spscRing.c"
+
+#define TEST_TASK_PRIORITY 5
+
+#define CONSUMER_TASK_PRIORITY 3
+
+#define TEST_RING_LENGTH 4
+
+/*Pop requested from the consumer task, along with its results*/
+static uint32_t popWaitTicks;
+
+static uint32_t popValue;
+
+static int popRetCode;
+
+static uint32_t popDoneTick;
+
+static bool popDone;
+
+SPSC_RING_DEFINE(testRing, TEST_RING_LENGTH, sizeof(uint32_t));
+
+SEMAPHORE_DEFINE(popStart, 0, 1);
+
+TASK_DEFINE(consumerTask, 1024, consumerTaskHandler, NULL, CONSUMER_TASK_PRIORITY);
+
+TASK_DEFINE(testTask, 4096, testTaskHandler, NULL, TEST_TASK_PRIORITY);
+
+void consumerTaskHandler(void *params)
+{
+    (void)params;
+
+    while (1)
+    {
+        semaphoreTake(&popStart, TASK_MAX_WAIT);
+
+        popRetCode = spscRingPop(&testRing, &popValue, popWaitTicks);
+
+        popDoneTick = osTicksGet();
+        popDone = true;
+    }
+}
+
+/**
+ * @brief Run a pop on the consumer task. The consumer task preempts the test task and runs until the pop
+ * completes or blocks.
+ */
+static void popStartOnConsumer(uint32_t waitTicks)
+{
+    popWaitTicks = waitTicks;
+    popValue = 0;
+    popDone = false;
+
+    semaphoreGive(&popStart);
+}
+
+/**
+ * @brief Push an item from the simulated ISR. Context switch requested by the push is taken on return to thread mode.
+ */
+static int pushFromISR(uint32_t value)
+{
+    hostHandlerMode = true;
+    int retCode = spscRingPushFromISR(&testRing, &value);
+    hostHandlerMode = false;
+
+    hostInterruptsTake();
+
+    return retCode;
+}
+
+static void testPushPop()
+{
+    uint32_t value;
+
+    for (uint32_t i = 0; i < TEST_RING_LENGTH; i++)
+    {
+        value = i;
+        TEST_CHECK_EQUAL(spscRingPush(&testRing, &value), RET_SUCCESS);
+    }
+
+    TEST_CHECK_EQUAL(spscRingPush(&testRing, &value), RET_FULL);
+    TEST_CHECK_EQUAL(pushFromISR(value), RET_FULL);
+    TEST_CHECK_EQUAL(spscRingCount(&testRing), TEST_RING_LENGTH);
+
+    for (uint32_t i = 0; i < TEST_RING_LENGTH; i++)
+    {
+        TEST_CHECK_EQUAL(spscRingPop(&testRing, &value, TASK_NO_WAIT), RET_SUCCESS);
+        TEST_CHECK_EQUAL(value, i);
+    }
+
+    TEST_CHECK_EQUAL(spscRingPop(&testRing, &value, TASK_NO_WAIT), RET_EMPTY);
+}
+
+/**
+ * @brief Blocked consumer task is woken up by a push from a task and from an ISR, and preempts the producer.
+ */
+static void testWakeup()
+{
+    popStartOnConsumer(TASK_MAX_WAIT);
+    TEST_CHECK_EQUAL(consumerTask.blockedReason, WAIT_FOR_SPSC_RING_ITEM);
+
+    uint32_t value = 10;
+
+    TEST_CHECK_EQUAL(spscRingPush(&testRing, &value), RET_SUCCESS);
+    TEST_CHECK_EQUAL(popDone, true);
+    TEST_CHECK_EQUAL(popRetCode, RET_SUCCESS);
+    TEST_CHECK_EQUAL(popValue, 10);
+    TEST_CHECK_EQUAL(testRing.consumerWaiting, false);
+
+    popStartOnConsumer(TASK_MAX_WAIT);
+    TEST_CHECK_EQUAL(popDone, false);
+
+    TEST_CHECK_EQUAL(pushFromISR(11), RET_SUCCESS);
+    TEST_CHECK_EQUAL(popDone, true);
+    TEST_CHECK_EQUAL(popRetCode, RET_SUCCESS);
+    TEST_CHECK_EQUAL(popValue, 11);
+}
+
+/**
+ * @brief Notification of the consumer task neither wakes it up from the ring nor is consumed by the ring.
+ */
+static void testNotification()
+{
+    /*Notification pending before the pop is left pending*/
+    taskNotify(&consumerTask, 0x1, TASK_NOTIFY_SET_BITS);
+
+    uint32_t startTick = osTicksGet();
+
+    popStartOnConsumer(5);
+    TEST_CHECK_EQUAL(popDone, false);
+
+    /*Notification sent while the consumer task is blocked does not wake it up*/
+    taskNotify(&consumerTask, 0x2, TASK_NOTIFY_SET_BITS);
+    TEST_CHECK_EQUAL(consumerTask.status, TASK_STATUS_BLOCKED);
+    TEST_CHECK_EQUAL(consumerTask.blockedReason, WAIT_FOR_SPSC_RING_ITEM);
+
+    taskSleep(10);
+
+    TEST_CHECK_EQUAL(popDone, true);
+    TEST_CHECK_EQUAL(popRetCode, RET_TIMEOUT);
+    TEST_CHECK_EQUAL(popDoneTick - startTick, 5);
+    TEST_CHECK_EQUAL(consumerTask.notifyPending, true);
+    TEST_CHECK_EQUAL(consumerTask.notifyValue, 0x3);
+
+    consumerTask.notifyPending = false;
+    consumerTask.notifyValue = 0;
+}
+
+/**
+ * @brief Push to the ring does not wake up the consumer task suspended while blocked; the item is popped once the
+ * task is resumed.
+ */
+static void testSuspended()
+{
+    popStartOnConsumer(TASK_MAX_WAIT);
+
+    taskSuspend(&consumerTask);
+
+    uint32_t value = 12;
+
+    TEST_CHECK_EQUAL(spscRingPush(&testRing, &value), RET_SUCCESS);
+    TEST_CHECK_EQUAL(consumerTask.status, TASK_STATUS_SUSPENDED);
+    TEST_CHECK_EQUAL(popDone, false);
+
+    taskResume(&consumerTask);
+
+    /*Resumed task does not preempt the current task by itself*/
+    taskYield();
+
+    TEST_CHECK_EQUAL(popDone, true);
+    TEST_CHECK_EQUAL(popRetCode, RET_SUCCESS);
+    TEST_CHECK_EQUAL(popValue, 12);
+}
+
+void testTaskHandler(void *params)
+{
+    (void)params;
+
+    testPushPop();
+
+    testWakeup();
+
+    testNotification();
+
+    testSuspended();
+
+    exit(hostTestResult("testSpscRing"));
+}
+
+int main()
+{
+    taskStart(&consumerTask);
+
+    taskStart(&testTask);
+
+    hostSchedulerStart();
+
+    return 0;
+}
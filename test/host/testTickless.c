@@ -0,0 +1,219 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Tickless idle on the simulated tick source. Simulated time only advances through the tick source; hence, wakeup
+ * accuracy and drift are checked exactly against the simulated CPU cycle count.
+ */
+
+#include <stdlib.h>
+#include "hostTest.h"
+#include "hostKernel.c"
+
+#define TICK_CYCLES ((uint64_t)OS_INTERVAL_CPU_TICKS)
+
+TASK_DEFINE(sleeperTask, 256, sleeperTaskHandler, NULL, 1);
+
+/*Sleeper task is never switched to; the test runs on its behalf*/
+void sleeperTaskHandler(void *params)
+{
+    (void)params;
+}
+
+TIMER_DEFINE(testTimer, testTimerHandler, TIMER_MODE_SINGLE_SHOT, NULL);
+
+void testTimerHandler(timerNodeType *pTimerNode, void *arg, uint32_t overruns)
+{
+    (void)pTimerNode;
+    (void)arg;
+    (void)overruns;
+}
+
+/*Number of times the idle task has slept with the tick suppressed*/
+static uint32_t idleWakeups = 0;
+
+/**
+ * @brief Run the idle task until the next interrupt and service the tick interrupt if it has fired. If the tick is
+ * not suppressed, the idle task spins until the next periodic tick.
+ */
+static void idleRun()
+{
+    uint64_t cycles = tickSourceSimCycles();
+
+    idleSuppressTicks();
+
+    if (tickSourceSimCycles() != cycles)
+    {
+        idleWakeups++;
+    }
+    else
+    {
+        tickSourceSimAdvanceTick();
+    }
+
+    if (tickSourceSimTickPending())
+    {
+        SYSTICK_HANDLER();
+    }
+}
+
+/**
+ * @brief Let the running sleeper task consume CPU for the given number of ticks with the periodic tick running.
+ */
+static void sleeperBusy(uint32_t ticks)
+{
+    while (ticks--)
+    {
+        tickSourceSimAdvanceTick();
+
+        if (tickSourceSimTickPending())
+        {
+            SYSTICK_HANDLER();
+        }
+    }
+}
+
+/**
+ * @brief Block the running sleeper task and run the idle task until the sleeper task runs again.
+ */
+static void sleeperSleep(uint32_t ticks)
+{
+    taskSleep(ticks);
+
+    TEST_CHECK_EQUAL(taskPool.currentTask, &idleTask);
+
+    while (taskPool.currentTask != &sleeperTask)
+    {
+        idleRun();
+
+        /*Tick count follows simulated time at every wakeup, early or not*/
+        TEST_CHECK_EQUAL(osTicksGet64(), tickSourceSimCycles() / TICK_CYCLES);
+    }
+}
+
+/**
+ * @brief Sleeper task wakes up exactly at the tick boundary of its timeout, after a single suppression.
+ */
+static void testWakeupAccuracy()
+{
+    uint64_t startTick = osTicksGet64();
+
+    idleWakeups = 0;
+
+    sleeperSleep(100);
+
+    TEST_CHECK_EQUAL(idleWakeups, 1);
+    TEST_CHECK_EQUAL(osTicksGet64(), startTick + 100);
+    TEST_CHECK_EQUAL(tickSourceSimCycles(), (startTick + 100) * TICK_CYCLES);
+    TEST_CHECK_EQUAL(sleeperTask.wakeupReason, SLEEP_TIME_TIMEOUT);
+}
+
+/**
+ * @brief Early wakeup by another interrupt accounts only the whole elapsed ticks, and the next suppression still ends
+ * at the original timeout.
+ */
+static void testEarlyWakeup()
+{
+    uint64_t startTick = osTicksGet64();
+
+    tickSourceSimRaiseInterrupt((startTick + 37) * TICK_CYCLES + TICK_CYCLES / 2);
+
+    taskSleep(100);
+
+    idleRun();
+
+    TEST_CHECK_EQUAL(osTicksGet64(), startTick + 37);
+    TEST_CHECK_EQUAL(sleeperTask.status, TASK_STATUS_BLOCKED);
+
+    while (taskPool.currentTask != &sleeperTask)
+    {
+        idleRun();
+    }
+
+    TEST_CHECK_EQUAL(osTicksGet64(), startTick + 100);
+    TEST_CHECK_EQUAL(tickSourceSimCycles(), (startTick + 100) * TICK_CYCLES);
+}
+
+/**
+ * @brief Random sleeps, busy periods and early wakeups accumulate no drift between tick count and simulated time.
+ */
+static void testNoDrift()
+{
+    srand(1);
+
+    for (int i = 0; i < 1000; i++)
+    {
+        sleeperBusy(rand() % 3);
+
+        uint32_t sleepTicks = 1 + rand() % 50;
+
+        uint64_t wakeupTick = osTicksGet64() + sleepTicks;
+
+        if (rand() % 2)
+        {
+            tickSourceSimRaiseInterrupt(tickSourceSimCycles() + rand() % (sleepTicks * TICK_CYCLES));
+        }
+
+        sleeperSleep(sleepTicks);
+
+        TEST_CHECK_EQUAL(osTicksGet64(), wakeupTick);
+        TEST_CHECK_EQUAL(tickSourceSimCycles(), wakeupTick * TICK_CYCLES);
+    }
+}
+
+/**
+ * @brief Running timer ends the suppression at its expiry tick even if no task times out earlier.
+ */
+static void testTimerWakeup()
+{
+    uint64_t startTick = osTicksGet64();
+
+    timerStart(&testTimer, 30);
+
+    taskSleep(100);
+
+    idleRun();
+
+    TEST_CHECK_EQUAL(osTicksGet64(), startTick + 30);
+    TEST_CHECK_EQUAL(testTimer.isPending, true);
+    TEST_CHECK_EQUAL(sleeperTask.status, TASK_STATUS_BLOCKED);
+}
+
+int main()
+{
+    hostKernelInit();
+
+    /*Sleeper task is running; idle task is ready*/
+    idleTask.status = TASK_STATUS_READY;
+    readyQueueAdd(&taskPool.readyQueue, &idleTask);
+    sleeperTask.status = TASK_STATUS_RUNNING;
+    taskPool.currentTask = currentTask = &sleeperTask;
+
+    testWakeupAccuracy();
+    testEarlyWakeup();
+    testNoDrift();
+    testTimerWakeup();
+
+    return hostTestResult("testTickless");
+}
@@ -0,0 +1,189 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Timing wheel against the reference timer model. Random one-shot and periodic timers, including timers beyond the
+ * range of the wheel, are started and stopped while the tick count wraps around. Every expiry and overrun of the wheel
+ * must match the model at the same tick.
+ */
+
+#include <stdlib.h>
+#include "hostTest.h"
+#include "hostKernel.c"
+#include "timerModel.h"
+
+#define TEST_TIMERS 200
+
+#define TEST_TICKS 1300000
+
+/*Range of the timing wheel in ticks*/
+#define WHEEL_RANGE_TICKS (1UL << (TIMER_WHEEL_SLOT_BITS * TIMER_WHEEL_LEVELS))
+
+static timerNodeType testTimers[TEST_TIMERS];
+
+static timerModelType testModels[TEST_TIMERS];
+
+/*Number of expiries of each timer, counted by the model and by the wheel, within the current step*/
+static uint32_t modelExpiries[TEST_TIMERS];
+
+static uint32_t wheelExpiries[TEST_TIMERS];
+
+void testTimerHandler(timerNodeType *pTimerNode, void *arg, uint32_t overruns)
+{
+    (void)pTimerNode;
+    (void)arg;
+    (void)overruns;
+}
+
+/**
+ * @brief Get a random timer interval. Most timers are short, some span several wheel levels and a few exceed the range
+ * of the wheel.
+ */
+static uint32_t randomInterval()
+{
+    switch (rand() % 16)
+    {
+    case 0:
+        return WHEEL_RANGE_TICKS + rand() % 200000;
+    case 1:
+    case 2:
+        return rand() % 100000;
+    default:
+        return rand() % 2000;
+    }
+}
+
+/**
+ * @brief Randomly start stopped timers and stop running ones, on the wheel and on the model alike.
+ */
+static void randomStartStop()
+{
+    uint32_t index = rand() % TEST_TIMERS;
+
+    if (testModels[index].isRunning)
+    {
+        /*Running timers are rarely stopped; most of them keep running until they expire*/
+        if (rand() % 8 == 0)
+        {
+            TEST_CHECK_EQUAL(timerStop(&testTimers[index]), RET_SUCCESS);
+
+            testModels[index].isRunning = false;
+        }
+    }
+    else
+    {
+        bool isPeriodic = rand() % 2;
+
+        uint32_t intervalTicks = randomInterval();
+
+        /*One-shot timer which expired on the wheel is stopped already*/
+        testTimers[index].mode = isPeriodic ? TIMER_MODE_PERIODIC : TIMER_MODE_SINGLE_SHOT;
+
+        TEST_CHECK_EQUAL(timerStart(&testTimers[index], intervalTicks), RET_SUCCESS);
+
+        timerModelStart(&testModels[index], intervalTicks, isPeriodic);
+    }
+}
+
+/**
+ * @brief Advance the wheel and the model by the given number of ticks and compare the expiries of every timer.
+ */
+static void step(uint32_t ticks)
+{
+    uint32_t minModelTicks = UINT32_MAX;
+
+    for (uint32_t i = 0; i < TEST_TIMERS; i++)
+    {
+        modelExpiries[i] = 0;
+        wheelExpiries[i] = 0;
+
+        if (testModels[i].isRunning && testModels[i].ticksToExpire < minModelTicks)
+        {
+            minModelTicks = testModels[i].ticksToExpire;
+        }
+    }
+
+    /*Tickless idle relies on the next expiry never being overestimated*/
+    TEST_CHECK_EQUAL(timerNextExpiryTicks() <= minModelTicks, true);
+
+    for (uint32_t tick = 0; tick < ticks; tick++)
+    {
+        for (uint32_t i = 0; i < TEST_TIMERS; i++)
+        {
+            modelExpiries[i] += timerModelTick(&testModels[i]);
+        }
+    }
+
+    processTimers(ticks);
+
+    /*Drain the Queue of pending timers as the timer task does*/
+    timerNodeType *pTimerNode;
+
+    while ((pTimerNode = timerPendingQueuePop(&timerPendingQueue)) != NULL)
+    {
+        wheelExpiries[(uintptr_t)pTimerNode->arg] += 1 + pTimerNode->overrunCount;
+
+        pTimerNode->overrunCount = 0;
+    }
+
+    for (uint32_t i = 0; i < TEST_TIMERS; i++)
+    {
+        TEST_CHECK_EQUAL(wheelExpiries[i], modelExpiries[i]);
+        TEST_CHECK_EQUAL(testTimers[i].isRunning, testModels[i].isRunning);
+    }
+}
+
+int main()
+{
+    hostKernelInit();
+
+    srand(1);
+
+    /*Tick count wraps around halfway through the test*/
+    timerWheelTime = UINT32_MAX - TEST_TICKS / 2;
+
+    for (uint32_t i = 0; i < TEST_TIMERS; i++)
+    {
+        timerModelNodeInit(&testTimers[i], testTimerHandler, TIMER_MODE_SINGLE_SHOT, (void *)(uintptr_t)i);
+    }
+
+    for (uint32_t tick = 0; tick < TEST_TICKS && hostTestFailures == 0;)
+    {
+        randomStartStop();
+
+        /*Several ticks are processed at once after tickless idle; long idle periods span cascades of higher levels*/
+        uint32_t ticks = (rand() % 16 == 0) ? 1 + rand() % 50 : 1;
+
+        if (rand() % 512 == 0)
+        {
+            ticks = 1 + rand() % 5000;
+        }
+
+        step(ticks);
+
+        tick += ticks;
+    }
+
+    return hostTestResult("testTimerWheel");
+}
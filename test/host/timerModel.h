@@ -0,0 +1,102 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __SANO_RTOS_HOST_TIMER_MODEL_H
+#define __SANO_RTOS_HOST_TIMER_MODEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Reference model of a software timer. Like the software timers before the timing wheel, every running timer counts
+ * down its remaining ticks on every tick; hence, it is simple enough to be obviously right, and its cost per tick
+ * grows with the number of running timers.
+ */
+typedef struct
+{
+    bool isRunning;
+    bool isPeriodic;
+    uint32_t intervalTicks;
+    uint32_t ticksToExpire;
+} timerModelType;
+
+/**
+ * @brief Start the reference timer. Timer with 0 interval expires on every tick, like the software timer.
+ *
+ * @param pModel Pointer to the timerModel struct
+ * @param intervalTicks Timer interval
+ * @param isPeriodic true if the timer is periodic
+ */
+static inline void timerModelStart(timerModelType *pModel, uint32_t intervalTicks, bool isPeriodic)
+{
+    pModel->isRunning = true;
+    pModel->isPeriodic = isPeriodic;
+    pModel->intervalTicks = intervalTicks ? intervalTicks : 1;
+    pModel->ticksToExpire = pModel->intervalTicks;
+}
+
+/**
+ * @brief Account one tick to the reference timer.
+ *
+ * @param pModel Pointer to the timerModel struct
+ * @retval true if the timer expires at this tick
+ * @retval false otherwise
+ */
+static inline bool timerModelTick(timerModelType *pModel)
+{
+    if (!pModel->isRunning || --pModel->ticksToExpire != 0)
+    {
+        return false;
+    }
+
+    if (pModel->isPeriodic)
+    {
+        pModel->ticksToExpire = pModel->intervalTicks;
+    }
+    else
+    {
+        pModel->isRunning = false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Initialize a timer node at run time, as TIMER_DEFINE does statically.
+ *
+ * @param pTimerNode Pointer to the timerNode struct
+ * @param timeoutHandler Timeout handler
+ * @param mode Timer mode
+ * @param arg Argument passed to the timeout handler
+ */
+static inline void timerModelNodeInit(timerNodeType *pTimerNode, timeoutHandlerType timeoutHandler, timerModeType mode, void *arg)
+{
+    *pTimerNode = (timerNodeType){
+        .timeoutHandler = timeoutHandler,
+        .arg = arg,
+        .mode = mode,
+        .overrunPolicy = TIMER_OVERRUN_COLLAPSE};
+}
+
+#endif
@@ -0,0 +1,146 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "osConfig.h"
+#include "tickSource.h"
+
+#if (OS_TICKLESS_IDLE) && !(OS_TICK_SOURCE_SIM)
+
+static uint32_t suppressedTicks; // Number of ticks programmed by the last call to tickSourceSuppress()
+
+static uint32_t reloadValue; // SysTick reload value programmed by the last call to tickSourceSuppress()
+
+/**
+ * @brief Get maximum number of ticks that can be suppressed at once. It is limited by the 24-bit SysTick reload register.
+ *
+ * @return Maximum number of ticks that can be suppressed
+ */
+uint32_t tickSourceMaxSuppressedTicks()
+{
+    return SysTick_LOAD_RELOAD_Msk / OS_INTERVAL_CPU_TICKS;
+}
+
+/**
+ * @brief Stop the periodic tick and program SysTick to interrupt idleTicks tick periods after the last tick boundary.
+ * Must be called with interrupts disabled.
+ *
+ * @param idleTicks Number of ticks to suppress.
+ * @retval true if tick is suppressed
+ * @retval false if a tick interrupt is already pending. Tick is left running in this case.
+ */
+bool tickSourceSuppress(uint32_t idleTicks)
+{
+    if (idleTicks > tickSourceMaxSuppressedTicks())
+    {
+        idleTicks = tickSourceMaxSuppressedTicks();
+    }
+
+    SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+
+    /*Tick boundary has passed while interrupts were disabled; Let the pending SysTick handler run first.*/
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+    {
+        SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+        return false;
+    }
+
+    /*Remaining cycles of the current tick period plus the cycles of the suppressed tick periods*/
+    reloadValue = SysTick->VAL + (idleTicks - 1) * OS_INTERVAL_CPU_TICKS;
+    suppressedTicks = idleTicks;
+
+    SysTick->LOAD = reloadValue;
+    SysTick->VAL = 0;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+    return true;
+}
+
+/**
+ * @brief Wait for an interrupt. Interrupts disabled through PRIMASK still wake the CPU.
+ */
+void tickSourceWaitForInterrupt()
+{
+    __DSB();
+    __WFI();
+    __ISB();
+}
+
+/**
+ * @brief Restart the periodic tick, aligned to the tick boundaries before suppression.
+ * Must be called with interrupts disabled.
+ *
+ * @return Number of whole ticks elapsed while suppressed, excluding the tick accounted by a pending SysTick interrupt.
+ */
+uint32_t tickSourceResume()
+{
+    uint32_t elapsedTicks;
+
+    SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+
+    uint32_t currentValue = SysTick->VAL;
+
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+    {
+        /*Woken up by the tick interrupt. Pending SysTick handler accounts for the last tick; program the remaining
+          cycles of the tick period that started when SysTick reached zero.*/
+        uint32_t cyclesSinceTick = reloadValue - currentValue;
+
+        SysTick->LOAD = (cyclesSinceTick < OS_INTERVAL_CPU_TICKS - 1) ? (OS_INTERVAL_CPU_TICKS - 1 - cyclesSinceTick) : (OS_INTERVAL_CPU_TICKS - 1);
+
+        elapsedTicks = suppressedTicks - 1;
+    }
+    else
+    {
+        /*Woken up by some other interrupt. Count the whole tick periods elapsed and program the cycles until the next tick boundary.*/
+        uint32_t elapsedCycles = suppressedTicks * OS_INTERVAL_CPU_TICKS - currentValue;
+
+        elapsedTicks = elapsedCycles / OS_INTERVAL_CPU_TICKS;
+
+        uint32_t remainingCycles = (elapsedTicks + 1) * OS_INTERVAL_CPU_TICKS - elapsedCycles;
+
+        /*SysTick period is LOAD + 1 cycles. LOAD of 0 would stop SysTick; tick boundary a cycle away counts as elapsed.*/
+        if (remainingCycles > 1)
+        {
+            SysTick->LOAD = remainingCycles - 1;
+        }
+        else
+        {
+            elapsedTicks++;
+
+            SysTick->LOAD = OS_INTERVAL_CPU_TICKS - 1;
+        }
+    }
+
+    SysTick->VAL = 0;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+    /*Next reload continues with the periodic tick*/
+    SysTick->LOAD = OS_INTERVAL_CPU_TICKS - 1;
+
+    return elapsedTicks;
+}
+
+#endif
@@ -0,0 +1,68 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __SANO_RTOS_TICK_SOURCE_H
+#define __SANO_RTOS_TICK_SOURCE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "osConfig.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /*
+     * Tick source used by the tickless idle mode. The periodic OS tick is suppressed while the idle task runs, and
+     * the tick source is reprogrammed to interrupt at the tick boundary of the earliest timeout. The default backend
+     * uses the SysTick timer. Defining OS_TICK_SOURCE_SIM selects a simulated backend which lets the tickless logic
+     * run on a host, with simulated time advancing in CPU cycles.
+     */
+
+    uint32_t tickSourceMaxSuppressedTicks();
+
+    bool tickSourceSuppress(uint32_t idleTicks);
+
+    void tickSourceWaitForInterrupt();
+
+    uint32_t tickSourceResume();
+
+#if OS_TICK_SOURCE_SIM
+
+    uint64_t tickSourceSimCycles();
+
+    void tickSourceSimAdvanceTick();
+
+    void tickSourceSimRaiseInterrupt(uint64_t atCycles);
+
+    bool tickSourceSimTickPending();
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,186 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "osConfig.h"
+#include "tickSource.h"
+
+#if (OS_TICKLESS_IDLE) && (OS_TICK_SOURCE_SIM)
+
+#define TICK_SOURCE_SIM_MAX_SUPPRESSED_TICKS 0xffff
+
+#define TICK_SOURCE_SIM_NO_INTERRUPT UINT64_MAX
+
+static uint64_t simCycles; // Current simulated time in CPU cycles
+
+static uint64_t simLastTickCycles; // Simulated time of the last tick boundary
+
+static uint64_t simWakeupCycles; // Simulated time at which the suppressed tick interrupt fires
+
+static uint64_t simInterruptCycles = TICK_SOURCE_SIM_NO_INTERRUPT; // Simulated time of the next non-tick interrupt
+
+static uint32_t suppressedTicks;
+
+static bool simTickFired;
+
+static bool simTickPending;
+
+/**
+ * @brief Get maximum number of ticks that can be suppressed at once.
+ *
+ * @return Maximum number of ticks that can be suppressed
+ */
+uint32_t tickSourceMaxSuppressedTicks()
+{
+    return TICK_SOURCE_SIM_MAX_SUPPRESSED_TICKS;
+}
+
+/**
+ * @brief Program the simulated tick interrupt idleTicks tick periods after the last tick boundary.
+ *
+ * @param idleTicks Number of ticks to suppress.
+ * @retval true if tick is suppressed
+ * @retval false if a tick interrupt is already pending
+ */
+bool tickSourceSuppress(uint32_t idleTicks)
+{
+    if (simTickPending)
+    {
+        return false;
+    }
+
+    if (idleTicks > TICK_SOURCE_SIM_MAX_SUPPRESSED_TICKS)
+    {
+        idleTicks = TICK_SOURCE_SIM_MAX_SUPPRESSED_TICKS;
+    }
+
+    suppressedTicks = idleTicks;
+    simWakeupCycles = simLastTickCycles + (uint64_t)idleTicks * OS_INTERVAL_CPU_TICKS;
+
+    return true;
+}
+
+/**
+ * @brief Advance simulated time to the earlier of the suppressed tick interrupt and the next raised interrupt.
+ */
+void tickSourceWaitForInterrupt()
+{
+    if (simInterruptCycles < simWakeupCycles)
+    {
+        /*Interrupt raised for a time that has already passed ends the wait immediately*/
+        if (simInterruptCycles > simCycles)
+        {
+            simCycles = simInterruptCycles;
+        }
+        simTickFired = false;
+    }
+    else
+    {
+        simCycles = simWakeupCycles;
+        simTickFired = true;
+    }
+
+    simInterruptCycles = TICK_SOURCE_SIM_NO_INTERRUPT;
+}
+
+/**
+ * @brief Restart the simulated periodic tick.
+ *
+ * @return Number of whole ticks elapsed while suppressed, excluding the tick accounted by a pending tick interrupt.
+ */
+uint32_t tickSourceResume()
+{
+    uint32_t elapsedTicks;
+
+    if (simTickFired)
+    {
+        /*Tick handler run by the host accounts for the last tick*/
+        elapsedTicks = suppressedTicks - 1;
+        simLastTickCycles = simWakeupCycles;
+        simTickPending = true;
+    }
+    else
+    {
+        elapsedTicks = (uint32_t)((simCycles - simLastTickCycles) / OS_INTERVAL_CPU_TICKS);
+        simLastTickCycles += (uint64_t)elapsedTicks * OS_INTERVAL_CPU_TICKS;
+    }
+
+    simTickFired = false;
+
+    return elapsedTicks;
+}
+
+/**
+ * @brief Get current simulated time.
+ *
+ * @return Simulated time in CPU cycles
+ */
+uint64_t tickSourceSimCycles()
+{
+    return simCycles;
+}
+
+/**
+ * @brief Advance simulated time to the next tick boundary of the periodic tick and mark the tick interrupt pending.
+ * Raised interrupt whose time has passed is considered serviced.
+ */
+void tickSourceSimAdvanceTick()
+{
+    simLastTickCycles += OS_INTERVAL_CPU_TICKS;
+    simCycles = simLastTickCycles;
+    simTickPending = true;
+
+    if (simInterruptCycles <= simCycles)
+    {
+        simInterruptCycles = TICK_SOURCE_SIM_NO_INTERRUPT;
+    }
+}
+
+/**
+ * @brief Raise a simulated non-tick interrupt which ends the next idle wait at the given time.
+ *
+ * @param atCycles Simulated time of the interrupt in CPU cycles
+ */
+void tickSourceSimRaiseInterrupt(uint64_t atCycles)
+{
+    simInterruptCycles = atCycles;
+}
+
+/**
+ * @brief Check and clear the pending simulated tick interrupt. Host calls the SysTick handler when this returns true.
+ *
+ * @retval true if tick interrupt was pending
+ * @retval false otherwise
+ */
+bool tickSourceSimTickPending()
+{
+    bool pending = simTickPending;
+
+    simTickPending = false;
+
+    return pending;
+}
+
+#endif
@@ -25,7 +25,6 @@
 #include <stdbool.h>
 #include <assert.h>
 #include <stdint.h>
-#include <stdlib.h>
 #include "retCodes.h"
 #include "scheduler/scheduler.h"
 #include "task/task.h"
@@ -33,122 +32,199 @@
 
 #define TIMER_TASK_PRIORITY TASK_HIGHEST_PRIORITY // timer task has the highest possible priority [lower the value, higher the priority]
 
-static timerListType timerList = {0}; // List of running timers
+/*Hierarchical timing wheel of running timers. Level 0 has one slot per tick; each slot of level n spans
+  TIMER_WHEEL_SLOTS^n ticks. Timers are placed by their expiry tick, and timers of a higher level slot are
+  cascaded down to lower levels when the wheel time reaches that slot.*/
+static timerListType timerWheel[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
 
-static timeoutHandlerQueueType timeoutHandlerQueue = {0}; // Queue of timeout handlers to be executed
+static uint32_t timerWheelTime = 0; // Current time of the timing wheel in ticks
+
+static uint32_t timerWheelCount[TIMER_WHEEL_LEVELS]; // Number of running timers in each level
+
+static timerPendingQueueType timerPendingQueue = {0}; // Queue of expired timers whose timeout handlers are yet to be executed
 
 /*Define timer task with highest possible priority*/
 TASK_DEFINE(timerTask, 1024, timerTaskFunction, NULL, TIMER_TASK_PRIORITY);
 
 /**
- * @brief Insert timeoutHandler node at the end of the Queue
+ * @brief Insert expired timer node at the end of the Queue of pending timers. The timer node itself is linked
+ * into the Queue; hence, no memory is allocated. If the timer is already pending, its timeout handler has not
+ * been executed since its previous expiry; the expiry is counted as an overrun instead and reported to the handler.
  *
- * @param pTimeoutHandlerQueue Pointer to the timeoutHandlerQueue struct
- * @param timeoutHandler timeoutHandler function
+ * @param pTimerPendingQueue Pointer to the timerPendingQueue struct
+ * @param pTimerNode Pointer to the timerNode struct
  */
-static void timeoutHandlerQueuePush(timeoutHandlerQueueType *pTimeoutHandlerQueue, timeoutHandlerType timeoutHandler)
+static void timerPendingQueuePush(timerPendingQueueType *pTimerPendingQueue, timerNodeType *pTimerNode)
 {
-    timeoutHandlerNodeType *newNode = (timeoutHandlerNodeType *)malloc(sizeof(timeoutHandlerNodeType));
-
-    assert(newNode != NULL);
+    if (pTimerNode->isPending)
+    {
+        pTimerNode->overrunCount++;
+        pTimerNode->totalOverrunCount++;
+        return;
+    }
 
-    newNode->timeoutHandler = timeoutHandler;
-    newNode->nextNode = NULL;
+    pTimerNode->isPending = true;
+    pTimerNode->nextPendingNode = NULL;
 
-    if (pTimeoutHandlerQueue->head == NULL)
+    if (pTimerPendingQueue->head == NULL)
     {
-        pTimeoutHandlerQueue->head = newNode;
-        pTimeoutHandlerQueue->tail = pTimeoutHandlerQueue->head;
+        pTimerPendingQueue->head = pTimerNode;
     }
     else
     {
-        pTimeoutHandlerQueue->tail->nextNode = newNode;
-        pTimeoutHandlerQueue->tail = newNode;
+        pTimerPendingQueue->tail->nextPendingNode = pTimerNode;
     }
+
+    pTimerPendingQueue->tail = pTimerNode;
 }
 
 /**
- * @brief Get timeoutHandler node from the front of the Queue
+ * @brief Get timer node from the front of the Queue of pending timers
  *
- * @param pTimeoutHandlerQueue
- * @retval timeoutHandler function
+ * @param pTimerPendingQueue Pointer to the timerPendingQueue struct
+ * @retval Pointer to the timerNode struct if exists
+ * @retval NULL if Queue is empty
  */
-static timeoutHandlerType timeoutHandlerQueuePop(timeoutHandlerQueueType *pTimeoutHandlerQueue)
+static timerNodeType *timerPendingQueuePop(timerPendingQueueType *pTimerPendingQueue)
 {
+    timerNodeType *pTimerNode = pTimerPendingQueue->head;
 
-    timeoutHandlerNodeType *temp = pTimeoutHandlerQueue->head->nextNode;
+    if (pTimerNode != NULL)
+    {
+        pTimerPendingQueue->head = pTimerNode->nextPendingNode;
 
-    timeoutHandlerType timeoutHandler = pTimeoutHandlerQueue->head->timeoutHandler;
+        pTimerNode->nextPendingNode = NULL;
+        pTimerNode->isPending = false;
+    }
 
-    free(pTimeoutHandlerQueue->head);
+    return pTimerNode;
+}
 
-    pTimeoutHandlerQueue->head = temp;
+/**
+ * @brief Get the timing wheel level of the specified slot
+ *
+ * @param pSlot Pointer to the slot of the timing wheel
+ * @return Level of the slot
+ */
+static inline uint32_t timerWheelLevel(timerListType *pSlot)
+{
+    return (uint32_t)(pSlot - &timerWheel[0][0]) / TIMER_WHEEL_SLOTS;
+}
 
-    return timeoutHandler;
+/**
+ * @brief Get index of the slot covering the specified time at the specified level.
+ *
+ * @param time Time in ticks
+ * @param level Level of the timing wheel
+ * @return Slot index
+ */
+static inline uint32_t timerWheelIndex(uint32_t time, uint32_t level)
+{
+    return (uint32_t)((uint64_t)time >> (TIMER_WHEEL_SLOT_BITS * level)) & TIMER_WHEEL_MASK;
 }
 
 /**
- * @brief Add a timer node to the list of running timers
+ * @brief Add a timer node to the timing wheel slot of its expiry tick
  *
- * @param pTimerList  Pointer to the timer list struct
  * @param pTimerNode  Pointer to the timerNode struct
  */
-static void timerListNodeAdd(timerListType *pTimerList, timerNodeType *pTimerNode)
+static void timerWheelNodeAdd(timerNodeType *pTimerNode)
 {
+    uint32_t ticks = pTimerNode->expiryTick - timerWheelTime;
+    uint32_t slotTime = pTimerNode->expiryTick;
+    uint32_t level = 0;
+
+    while (level < TIMER_WHEEL_LEVELS - 1 && (uint64_t)ticks >= ((uint64_t)1 << (TIMER_WHEEL_SLOT_BITS * (level + 1))))
+    {
+        level++;
+    }
+
+    /*Timer expires beyond the range of the timing wheel. Place it at the farthest slot; it is placed again
+      by its expiry tick when the slot is cascaded.*/
+    if ((uint64_t)ticks >= ((uint64_t)1 << (TIMER_WHEEL_SLOT_BITS * TIMER_WHEEL_LEVELS)))
+    {
+        slotTime = timerWheelTime + (uint32_t)(((uint64_t)1 << (TIMER_WHEEL_SLOT_BITS * TIMER_WHEEL_LEVELS)) - 1);
+    }
+
+    timerListType *pSlot = &timerWheel[level][timerWheelIndex(slotTime, level)];
+
+    pTimerNode->prevNode = NULL;
+    pTimerNode->nextNode = pSlot->head;
+
+    if (pSlot->head != NULL)
+    {
+        pSlot->head->prevNode = pTimerNode;
+    }
 
-    pTimerNode->nextNode = pTimerList->head;
+    pSlot->head = pTimerNode;
+    pTimerNode->pSlot = pSlot;
 
-    pTimerList->head = pTimerNode;
+    timerWheelCount[level]++;
 }
 
 /**
- * @brief Delete the timerNode from the beginning of the list
+ * @brief Delete a timer node from the timing wheel
  *
- * @param pTimerList Pointer to the timerNode struct
+ * @param pTimerNode Pointer to the timerNode struct.
  */
-static inline void timerListDeleteFirstNode(timerListType *pTimerList)
+static void timerWheelNodeDelete(timerNodeType *pTimerNode)
 {
-    timerNodeType *tempNode = pTimerList->head->nextNode;
+    if (pTimerNode->prevNode != NULL)
+    {
+        pTimerNode->prevNode->nextNode = pTimerNode->nextNode;
+    }
+    else
+    {
+        pTimerNode->pSlot->head = pTimerNode->nextNode;
+    }
 
-    pTimerList->head->nextNode = NULL;
+    if (pTimerNode->nextNode != NULL)
+    {
+        pTimerNode->nextNode->prevNode = pTimerNode->prevNode;
+    }
 
-    pTimerList->head = tempNode;
+    timerWheelCount[timerWheelLevel(pTimerNode->pSlot)]--;
+
+    pTimerNode->nextNode = NULL;
+    pTimerNode->prevNode = NULL;
+    pTimerNode->pSlot = NULL;
 }
 
 /**
- * @brief Delete a specified timerNode from the list of running timers.
+ * @brief Move timers of the current slot of the specified level to the lower levels.
  *
- * @param pTimerList Pointer to the timerList struct.
- * @param pTimerNode Pointer to the timerNode struct.
- * @retval RET_SUCCESS if timerNode deleted successfully
- * @retval RET_EMPTY if timerList is empty
+ * @param level Level of the timing wheel
  */
-static int timerListNodeDelete(timerListType *pTimerList, timerNodeType *pTimerNode)
+static void timerWheelCascade(uint32_t level)
 {
+    timerListType *pSlot = &timerWheel[level][timerWheelIndex(timerWheelTime, level)];
 
-    if (pTimerList->head != NULL) // Check if timerList is empty
+    while (pSlot->head != NULL)
     {
-        timerNodeType *currentNode = pTimerList->head;
+        timerNodeType *pTimerNode = pSlot->head;
 
-        /* If the timer correponds to the head node in the list, remove the timer node and reassign head node.*/
-        if (pTimerNode == pTimerList->head)
-            timerListDeleteFirstNode(pTimerList);
+        timerWheelNodeDelete(pTimerNode);
 
-        else
-        {
-            while (currentNode->nextNode != pTimerNode)
-                currentNode = currentNode->nextNode;
-
-            currentNode->nextNode = pTimerNode->nextNode;
-            pTimerNode->nextNode = NULL;
-        }
-        return RET_SUCCESS;
+        timerWheelNodeAdd(pTimerNode);
     }
-    return RET_EMPTY;
 }
 
 /**
- * @brief  Function to start the timer. This stores the timerNode in the list of running timers.
+ * @brief Stop the timer. Must be called with interrupts disabled.
+ *
+ * @param pTimerNode Pointer to timerNode struct
+ */
+static inline void timerStopUnsafe(timerNodeType *pTimerNode)
+{
+    pTimerNode->isRunning = false;
+
+    timerWheelNodeDelete(pTimerNode);
+}
+
+/**
+ * @brief  Function to start the timer. This stores the timerNode in the timing wheel of running timers.
+ * Expiries of a periodic timer are anchored to the start tick and occur exactly every intervalTicks thereafter,
+ * regardless of when the timeout handler gets executed.
  *
  * @param pTimerNode Pointer timerNode struct
  * @param intervalTicks Timer intervalTicks
@@ -159,80 +235,176 @@ int timerStart(timerNodeType *pTimerNode, uint32_t intervalTicks)
 {
     assert(pTimerNode != NULL);
 
+    int retCode;
+
+    ENTER_CRITICAL_SECTION();
+
     /* check if the timer is already in running state. If so, abort re-starting the timer.*/
     if (pTimerNode->isRunning)
-        return RET_ALREADYACTIVE;
+    {
+        retCode = RET_ALREADYACTIVE;
+    }
+    else
+    {
+        /* Set isRunning flag for the started timer pTimerNode.*/
+        pTimerNode->isRunning = true;
+
+        pTimerNode->intervalTicks = intervalTicks;
 
-    /* Set isRunning flag for the started timer pTimerNode.*/
-    pTimerNode->isRunning = true;
+        /*Timer with 0 interval expires on the next tick*/
+        pTimerNode->expiryTick = timerWheelTime + (intervalTicks ? intervalTicks : 1);
 
-    pTimerNode->ticksToExpire = pTimerNode->intervalTicks = intervalTicks;
+        /* Add the timer to the timing wheel of running timers*/
+        timerWheelNodeAdd(pTimerNode);
 
-    /* Add the timer in the queue of running timers*/
-    timerListNodeAdd(&timerList, pTimerNode);
+        retCode = RET_SUCCESS;
+    }
+
+    EXIT_CRITICAL_SECTION();
 
-    return RET_SUCCESS;
+    return retCode;
 }
 
 /**
  * @brief Function to stop the specified timerNode. This sets isRunning flag to false to prevent subsequent events from this timer
- *  and delete timer from the list of running timers
+ *  and delete timer from the timing wheel of running timers
  *
  * @param pTimerNode Pointer to timerNode struct
  * @retval RET_SUCCESS if timer stopped successfully
- * @retval RET_EMPTY if timerList is empty
  * @retval RET_NOTACTIVE if timer is not running
  */
 int timerStop(timerNodeType *pTimerNode)
 {
     assert(pTimerNode != NULL);
 
+    int retCode = RET_NOTACTIVE;
+
+    ENTER_CRITICAL_SECTION();
+
     if (pTimerNode->isRunning)
     {
-        pTimerNode->isRunning = false;
-        return timerListNodeDelete(&timerList, pTimerNode);
+        timerStopUnsafe(pTimerNode);
+
+        retCode = RET_SUCCESS;
     }
-    return RET_NOTACTIVE;
+
+    EXIT_CRITICAL_SECTION();
+
+    return retCode;
 }
 
 /**
- * @brief Check for timer timeout and add the corresponding timeout handler to the
- *  Queue of timeout handlers
+ * @brief Advance the timing wheel by one tick and add the expired timers to the
+ *  Queue of pending timers. Only the timers expiring at this tick, and occasionally the timers of a cascaded slot, are visited.
  */
-void processTimers()
+static void timerWheelTick()
 {
-    if (timerList.head != NULL) // Check if timer list is empty
+    timerWheelTime++;
+
+    /*Cascade higher level slots whenever the lower level wraps around*/
+    for (uint32_t level = 1; level < TIMER_WHEEL_LEVELS && timerWheelIndex(timerWheelTime, level - 1) == 0; level++)
     {
-        timerNodeType *currentNode = timerList.head;
-        while (currentNode != NULL)
+        timerWheelCascade(level);
+    }
+
+    timerListType *pSlot = &timerWheel[0][timerWheelIndex(timerWheelTime, 0)];
+
+    while (pSlot->head != NULL)
+    {
+        timerNodeType *currentNode = pSlot->head;
+
+        timerWheelNodeDelete(currentNode);
+
+        /*Add timer to the Queue of pending timers*/
+        timerPendingQueuePush(&timerPendingQueue, currentNode);
+
+        /* Check if timer task is suspended. If so, change status to ready to allow execution.*/
+        if (timerTask.status == TASK_STATUS_BLOCKED)
+            taskSetReady(&timerTask, TIMER_TIMEOUT);
+
+        /* Check if the timer mode is SINGLE_SHOT. If true, stop the correponding timer. Otherwise, place the timer
+           at its next expiry tick.*/
+        if (currentNode->mode == TIMER_MODE_SINGLE_SHOT)
+        {
+            currentNode->isRunning = false;
+        }
+        else
         {
-            /*Save next node to avoid losing track of linked list after a time node is deleted while stopping the timer*/
-            timerNodeType *nextNode = currentNode->nextNode;
+            /*Next expiry is computed from the previous expiry, not from the current time; hence, period error never accumulates.*/
+            currentNode->expiryTick += (currentNode->intervalTicks ? currentNode->intervalTicks : 1);
+
+            timerWheelNodeAdd(currentNode);
+        }
+    }
+}
 
-            /*Decrement ticks to expire*/
-            if (currentNode->ticksToExpire > 0)
-                currentNode->ticksToExpire--;
+/**
+ * @brief Check for timer timeout and add the expired timers to the
+ *  Queue of pending timers. Ticks without any timer expiry or cascade are skipped at once; hence, the time spent
+ *  after tickless idle is bounded by the number of timer events in the elapsed ticks, not by the number of elapsed ticks.
+ * @param elapsedTicks Number of ticks elapsed since the previous call. This is 1 unless ticks were suppressed while idle.
+ */
+void processTimers(uint32_t elapsedTicks)
+{
+    while (elapsedTicks != 0)
+    {
+        if (elapsedTicks > 1)
+        {
+            /*Ticks before the next timer event leave the timing wheel unchanged except for its time*/
+            uint32_t emptyTicks = timerNextExpiryTicks() - 1;
 
-            /* Check if timer has expired.If set, call the timeoutHandler() and update the ticksToExpire for next event.*/
-            if (currentNode->ticksToExpire == 0)
+            if (emptyTicks > elapsedTicks - 1)
             {
+                emptyTicks = elapsedTicks - 1;
+            }
 
-                /*Add timeout handler to the timeoutHandlerQueue*/
-                timeoutHandlerQueuePush(&timeoutHandlerQueue, currentNode->timeoutHandler);
+            timerWheelTime += emptyTicks;
+            elapsedTicks -= emptyTicks;
+        }
+
+        timerWheelTick();
+        elapsedTicks--;
+    }
+}
 
-                /* Check if timer task is suspended. If so, change status to ready to allow execution.*/
-                if (timerTask.status == TASK_STATUS_BLOCKED)
-                    taskSetReady(&timerTask, TIMER_TIMEOUT);
+/**
+ * @brief Get number of ticks until the earliest timer timeout or cascade of a non-empty slot of the timing wheel.
+ * This is only a lower bound of the earliest timer timeout.
+ *
+ * @retval Number of ticks until the earliest timer event
+ * @retval TASK_MAX_WAIT if no timer is running
+ */
+uint32_t timerNextExpiryTicks()
+{
+    uint64_t ticks = TASK_MAX_WAIT;
 
-                currentNode->ticksToExpire = currentNode->intervalTicks;
+    for (uint32_t level = 0; level < TIMER_WHEEL_LEVELS; level++)
+    {
+        if (timerWheelCount[level] == 0)
+        {
+            continue;
+        }
+
+        uint64_t levelTime = (uint64_t)timerWheelTime >> (TIMER_WHEEL_SLOT_BITS * level);
+
+        /*Find the next non-empty slot of the level. Slots of level 0 expire at the slot time,
+          while slots of higher levels are cascaded at the slot time*/
+        for (uint32_t slot = 1; slot <= TIMER_WHEEL_SLOTS; slot++)
+        {
+            if (timerWheel[level][(levelTime + slot) & TIMER_WHEEL_MASK].head != NULL)
+            {
+                uint64_t slotTicks = ((levelTime + slot) << (TIMER_WHEEL_SLOT_BITS * level)) - timerWheelTime;
 
-                /* Check if the timer mode is SINGLE_SHOT. If true, stop the correponding timer*/
-                if (currentNode->mode == TIMER_MODE_SINGLE_SHOT)
-                    timerStop(currentNode);
+                if (slotTicks < ticks)
+                {
+                    ticks = slotTicks;
+                }
+                break;
             }
-            currentNode = nextNode;
         }
     }
+
+    return (uint32_t)ticks;
 }
 
 /**
@@ -256,15 +428,42 @@ void timerTaskFunction(void *args)
 
     while (1)
     {
-        if (timeoutHandlerQueue.head != NULL) // Check for non-empty condition
+        ENTER_CRITICAL_SECTION();
+
+        timerNodeType *pTimerNode = timerPendingQueuePop(&timerPendingQueue);
+
+        if (pTimerNode != NULL)
         {
-            timeoutHandlerType timeoutHandler = timeoutHandlerQueuePop(&timeoutHandlerQueue);
-            timeoutHandler();
+            timeoutHandlerType timeoutHandler = pTimerNode->timeoutHandler;
+
+            uint32_t overruns = pTimerNode->overrunCount;
+
+            uint32_t handlerCalls = 1;
+
+            pTimerNode->overrunCount = 0;
+
+            /*Replay missed expiries one by one if requested*/
+            if (pTimerNode->overrunPolicy == TIMER_OVERRUN_CATCH_UP)
+            {
+                handlerCalls += overruns;
+                overruns = 0;
+            }
+
+            EXIT_CRITICAL_SECTION();
+
+            while (handlerCalls--)
+            {
+                timeoutHandler(pTimerNode, pTimerNode->arg, overruns);
+            }
         }
         else
         {
-            /* Block timer task and give cpu to other tasks while waiting for timeout*/
-            taskBlock(&timerTask, WAIT_FOR_TIMER_TIMEOUT, 0);
+            /* Block timer task and give cpu to other tasks while waiting for timeout. Blocking within the same
+               critical section as the check for pending timers ensures that a timer expiring in between is not missed.
+               taskBlock() releases the critical section while the task is blocked and re-enters it on wakeup.*/
+            taskBlock(&timerTask, WAIT_FOR_TIMER_TIMEOUT, TASK_MAX_WAIT);
+
+            EXIT_CRITICAL_SECTION();
         }
     }
 }
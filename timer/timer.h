@@ -40,60 +40,99 @@ extern "C"
         TIMER_MODE_PERIODIC
     } timerModeType;
 
+    /*Handling of periodic timer expiries missed while the timeout handler was still pending*/
+    typedef enum
+    {
+        TIMER_OVERRUN_COLLAPSE, // Collapse missed expiries into one handler call, which receives the number of missed expiries
+        TIMER_OVERRUN_CATCH_UP  // Call the handler once for every missed expiry
+    } timerOverrunPolicyType;
+
 /**
  * @brief Statically define and initialize a timer.
  * @param name Name of the timer.
  * @param timeout_handler Function to execute on timer timeout.
  * @param timer_mode Timer mode[PERIODIC or SINGLE_SHOT].
+ * @param timer_arg Argument passed to the timeout handler. This lets one timeout handler serve many timers.
  *
  */
-#define TIMER_DEFINE(name, timeout_handler, timer_mode) \
-    void timeout_handler(void);                         \
-    timerNodeType name = {                              \
-        .isRunning = false,                             \
-        .mode = timer_mode,                             \
-        .timeoutHandler = timeout_handler,              \
-        .ticksToExpire = 0,                             \
-        .intervalTicks = 0,                             \
-        .nextNode = NULL}
-
-    typedef void (*timeoutHandlerType)(void); // Timeout handler function type definition
+#define TIMER_DEFINE(name, timeout_handler, timer_mode, timer_arg)                 \
+    void timeout_handler(timerNodeType *pTimerNode, void *arg, uint32_t overruns); \
+    timerNodeType name = {                                                         \
+        .isRunning = false,                                                        \
+        .mode = timer_mode,                                                        \
+        .timeoutHandler = timeout_handler,                                         \
+        .arg = timer_arg,                                                          \
+        .expiryTick = 0,                                                           \
+        .intervalTicks = 0,                                                        \
+        .nextNode = NULL,                                                          \
+        .prevNode = NULL,                                                          \
+        .pSlot = NULL,                                                             \
+        .nextPendingNode = NULL,                                                   \
+        .overrunCount = 0,                                                         \
+        .totalOverrunCount = 0,                                                    \
+        .overrunPolicy = TIMER_OVERRUN_COLLAPSE,                                   \
+        .isPending = false}
+
+/*Number of slots of each level of the timing wheel*/
+#define TIMER_WHEEL_SLOTS (1UL << TIMER_WHEEL_SLOT_BITS)
+#define TIMER_WHEEL_MASK (TIMER_WHEEL_SLOTS - 1)
+
+    typedef struct timerNode timerNodeType;
+
+    /*Timeout handler function type definition. The handler receives the expired timer, its argument and the
+      number of expiries missed since the handler was last executed.*/
+    typedef void (*timeoutHandlerType)(timerNodeType *pTimerNode, void *arg, uint32_t overruns);
 
     /*Timer node structure*/
-    typedef struct timerNode
+    struct timerNode
     {
         timeoutHandlerType timeoutHandler;
+        void *arg;
         uint32_t intervalTicks;
-        uint32_t ticksToExpire;
+        uint32_t expiryTick;
         struct timerNode *nextNode;
+        struct timerNode *prevNode;
+        struct timerList *pSlot;           // Slot of the timing wheel the timer is placed in
+        struct timerNode *nextPendingNode; // Links the expired timer into the Queue of pending timers
+        uint32_t overrunCount;             // Number of expiries missed since the timeout handler was last executed
+        uint32_t totalOverrunCount;        // Number of expiries missed since the timer was defined
+        timerOverrunPolicyType overrunPolicy;
         timerModeType mode;
         bool isRunning;
+        bool isPending;
 
-    } timerNodeType;
-
-    typedef struct timeoutHandlerNode
-    {
-        timeoutHandlerType timeoutHandler;
-        struct timeoutHandlerNode *nextNode;
-
-    } timeoutHandlerNodeType;
+    };
 
     typedef struct
     {
-        timeoutHandlerNodeType *head;
-        timeoutHandlerNodeType *tail;
-    } timeoutHandlerQueueType;
+        timerNodeType *head;
+        timerNodeType *tail;
+    } timerPendingQueueType;
 
-    typedef struct
+    typedef struct timerList
     {
         timerNodeType *head;
     } timerListType;
 
+    /**
+     * @brief Set how expiries missed while the timeout handler was still pending are handled. Missed expiries are only
+     * counted; hence, a slow handler never causes memory to be consumed.
+     *
+     * @param pTimerNode Pointer to timerNode struct
+     * @param overrunPolicy TIMER_OVERRUN_COLLAPSE or TIMER_OVERRUN_CATCH_UP
+     */
+    static inline void timerSetOverrunPolicy(timerNodeType *pTimerNode, timerOverrunPolicyType overrunPolicy)
+    {
+        pTimerNode->overrunPolicy = overrunPolicy;
+    }
+
     int timerStart(timerNodeType *pTimerNode, uint32_t interval);
 
     int timerStop(timerNodeType *pTimerNode);
 
-    void processTimers();
+    void processTimers(uint32_t elapsedTicks);
+
+    uint32_t timerNextExpiryTicks();
 
     void timerTaskStart();
 